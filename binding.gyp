@@ -1,26 +1,30 @@
 {
   "targets": [
     {
-      "target_name": "smbios",
-      "product_dir": "<(module_path)",
+      "target_name": "smbios-core",
+      "type": "static_library",
+      "standalone_static_library": 1,
       "cflags!": [ "-fno-exceptions" ],
       "cflags_cc!": [ "-fno-exceptions" ],
       "cflags_cc": [ "-std=c++17" ],
       "sources": [
-        "src/binding.cpp",
-        "src/smbios_common.cpp"
-      ],
-      "include_dirs": [
-        "<!@(node -p \"require('node-addon-api').include\")"
-      ],
-      "defines": [ 
-        "NAPI_DISABLE_CPP_EXCEPTIONS",
-        "NAPI_VERSION=<(napi_build_version)"
+        "src/smbios_common.cpp",
+        "src/smbios_cpu_features.cpp",
+        "src/smbios_cpuid.cpp",
+        "src/smbios_metrics.cpp",
+        "src/smbios_records.cpp",
+        "src/smbios_serialize.cpp",
+        "src/smbios_shared.cpp",
+        "src/smbios_snapshot.cpp",
+        "src/smbios_table.cpp",
+        "src/smbios_virtualization.cpp"
       ],
+      "direct_dependent_settings": {
+        "include_dirs": [ "src" ]
+      },
       "conditions": [
         ["OS=='win'", {
           "sources": [ "src/windows/smbios_windows.cpp" ],
-          "libraries": [],
           "msvs_settings": {
             "VCCLCompilerTool": {
               "ExceptionHandling": 1,
@@ -44,7 +48,83 @@
           }
         }],
         ["OS=='linux'", {
-          "sources": [ "src/linux/smbios_linux.cpp" ]
+          "cflags": [ "-fPIC" ],
+          "sources": [
+            "src/linux/smbios_linux.cpp",
+            "src/linux/sysfs_file.cpp",
+            "src/linux/cpufreq_linux.cpp",
+            "src/linux/numa_linux.cpp",
+            "src/linux/cache_linux.cpp",
+            "src/linux/limits_linux.cpp",
+            "src/linux/stats_linux.cpp",
+            "src/linux/thermal_linux.cpp"
+          ]
+        }]
+      ]
+    },
+    {
+      "target_name": "smbios",
+      "product_dir": "<(module_path)",
+      "dependencies": [ "smbios-core" ],
+      "cflags!": [ "-fno-exceptions" ],
+      "cflags_cc!": [ "-fno-exceptions" ],
+      "cflags_cc": [ "-std=c++17" ],
+      "sources": [
+        "src/binding.cpp"
+      ],
+      "include_dirs": [
+        "<!@(node -p \"require('node-addon-api').include\")"
+      ],
+      "defines": [
+        "NAPI_DISABLE_CPP_EXCEPTIONS",
+        "NAPI_VERSION=<(napi_build_version)"
+      ],
+      "conditions": [
+        ["OS=='win'", {
+          "libraries": [],
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "ExceptionHandling": 1,
+              "AdditionalOptions": [ "/std:c++17" ]
+            }
+          }
+        }],
+        ["OS=='mac'", {
+          "xcode_settings": {
+            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+            "CLANG_CXX_LANGUAGE_STANDARD": "c++17",
+            "CLANG_CXX_LIBRARY": "libc++",
+            "MACOSX_DEPLOYMENT_TARGET": "10.13"
+          }
+        }]
+      ]
+    },
+    {
+      "target_name": "smbios-cli",
+      "type": "executable",
+      "dependencies": [ "smbios-core" ],
+      "cflags!": [ "-fno-exceptions" ],
+      "cflags_cc!": [ "-fno-exceptions" ],
+      "cflags_cc": [ "-std=c++17" ],
+      "sources": [
+        "src/cli/main.cpp"
+      ],
+      "conditions": [
+        ["OS=='win'", {
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "ExceptionHandling": 1,
+              "AdditionalOptions": [ "/std:c++17" ]
+            }
+          }
+        }],
+        ["OS=='mac'", {
+          "xcode_settings": {
+            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+            "CLANG_CXX_LANGUAGE_STANDARD": "c++17",
+            "CLANG_CXX_LIBRARY": "libc++",
+            "MACOSX_DEPLOYMENT_TARGET": "10.13"
+          }
         }]
       ]
     }
@@ -82,6 +82,103 @@ try {
     console.log('Thermal State:', chassisInfo.thermalState || 'N/A');
     console.log();
 
+    // Get per-socket processor records
+    console.log('--- Processor Sockets ---');
+    for (const proc of smbios.getProcessors()) {
+        console.log(`${proc.socketDesignation}: ${proc.version} ${proc.coreEnabled}/${proc.coreCount} cores, ${proc.maxSpeed} MHz max`);
+        for (const cache of proc.caches) {
+            console.log(`  L${cache.level} ${cache.cacheType}: ${cache.installedSize} bytes`);
+        }
+    }
+    console.log();
+
+    // Sample per-core frequencies
+    const frequencies = smbios.sampleCpuFrequencies();
+    console.log('--- CPU Frequencies (MHz) ---');
+    console.log(Array.from(frequencies, (mhz) => (Number.isNaN(mhz) ? 'N/A' : mhz.toFixed(0))).join(' ') || 'N/A');
+    console.log();
+
+    // Get limits that apply to this process (containers, cgroups)
+    const limits = smbios.getEffectiveLimits();
+    console.log('--- Effective Limits ---');
+    console.log(`CPUs: ${limits.effectiveCpus} of ${limits.hostCpus}${limits.cpuQuota ? ` (quota ${limits.cpuQuota})` : ''}`);
+    console.log(`Memory: ${(limits.effectiveMemory / 1024 ** 3).toFixed(1)} GiB of ${(limits.hostMemory / 1024 ** 3).toFixed(1)} GiB${limits.source ? ` (${limits.source})` : ''}`);
+    console.log();
+
+    // Poll numeric stats into reusable typed arrays
+    const mem = new Float64Array(7);
+    const cpu = new Float64Array(2 + 2 * 256);
+    smbios.fillMemoryStats(mem);
+    smbios.fillCpuStats(cpu);
+    console.log('--- Memory / CPU Stats ---');
+    console.log(`Available: ${(mem[2] / 1024 ** 3).toFixed(1)} GiB of ${(mem[0] / 1024 ** 3).toFixed(1)} GiB`);
+    console.log(`CPUs: ${cpu[0]}, load since boot: ${(cpu[1] * 100).toFixed(1)}%`);
+    console.log();
+
+    // Detect the virtualization environment
+    console.log('--- Virtualization ---');
+    const virt = smbios.getVirtualization();
+    console.log(virt.virtualized ? `Guest of ${virt.hypervisor} (via ${virt.source})` : 'Bare metal');
+    console.log();
+
+    // Get CPU feature flags
+    console.log('--- CPU Features ---');
+    console.log(smbios.getCpuFeatures().join(' ') || 'N/A');
+    console.log(`AVX2: ${smbios.hasCpuFeature('avx2')}, AVX-512F: ${smbios.hasCpuFeature('avx512f')}, AES: ${smbios.hasCpuFeature('aes')}`);
+    console.log();
+
+    // Get NUMA layout
+    console.log('--- NUMA Nodes ---');
+    for (const node of smbios.getNumaNodes()) {
+        const freeGiB = (node.memFree / 1024 ** 3).toFixed(1);
+        console.log(`Node ${node.id}: CPUs ${node.cpus.join(',')}, ${freeGiB} GiB free, distances ${node.distances.join(' ')}`);
+    }
+    console.log();
+
+    // Get cache hierarchy
+    console.log('--- Cache Topology ---');
+    for (const cache of smbios.getCacheTopology()) {
+        console.log(`L${cache.level} ${cache.type}: ${cache.size / 1024} KB, ${cache.ways}-way, ${cache.lineSize} B lines, CPUs ${cache.cpus.join(',')}`);
+    }
+    console.log();
+
+    // Read temperature sensors
+    console.log('--- Thermal Sensors ---');
+    const sensors = smbios.getThermalSensors();
+    const temps = new Float64Array(2 + sensors.length);
+    smbios.fillTemperatures(temps);
+    sensors.forEach((sensor, i) => {
+        console.log(`${sensor.name} ${sensor.label}: ${temps[2 + i]} °C (warning ${sensor.warning || 'N/A'}, critical ${sensor.critical || 'N/A'})`);
+    });
+    console.log();
+
+    // Get expansion slots and onboard devices
+    console.log('--- System Slots ---');
+    for (const slot of smbios.getSystemSlots()) {
+        console.log(`${slot.designation}: ${slot.slotType} (${slot.dataBusWidth}) ${slot.currentUsage} ${slot.pciAddress || ''}`);
+    }
+    console.log('--- Onboard Devices ---');
+    for (const device of smbios.getOnboardDevices()) {
+        console.log(`${device.referenceDesignation}: ${device.deviceType} ${device.pciAddress || ''}`);
+    }
+    console.log();
+
+    // Follow handle references through the raw SMBIOS table
+    console.log('--- Raw SMBIOS Table ---');
+    for (const proc of smbios.getByType(4)) {
+        const l2Handle = proc.data.length >= 0x1E ? proc.data.readUInt16LE(0x1C) : 0xFFFF;
+        const l2 = smbios.findByHandle(l2Handle);
+        console.log(`Processor 0x${proc.handle.toString(16)} L2 cache:`, l2 ? l2.strings[0] || 'present' : 'N/A');
+    }
+    console.log();
+
+    // Compact binary snapshot
+    console.log('--- Serialized Snapshot ---');
+    const packed = smbios.serializeSnapshot();
+    const json = JSON.stringify(smbios.deserializeSnapshot(packed));
+    console.log(`${packed.length} bytes (JSON: ${json.length} bytes), changes since encoding: ${smbios.diffSnapshots(packed).length}`);
+    console.log();
+
     // Get all information at once
     console.log('--- All Information (Single Call) ---');
     const allInfo = smbios.getAllInfo();
@@ -1,95 +1,309 @@
 #include <napi.h>
-#include "smbios_common.h"
+#include <algorithm>
+#include <cmath>
+#include "smbios.h"
+#include "smbios_fields.h"
+#include "smbios_table.h"
 
 namespace smbios {
 
 /**
- * Convert BiosInfo struct to JavaScript object
+ * Convert an info struct (BiosInfo, SystemInfo, ... or their views) to JavaScript object
  */
-Napi::Object BiosInfoToObject(Napi::Env env, const BiosInfo& info) {
+template <typename T>
+Napi::Object InfoToObject(Napi::Env env, const T& info) {
     Napi::Object obj = Napi::Object::New(env);
-    obj.Set("vendor", Napi::String::New(env, info.vendor));
-    obj.Set("version", Napi::String::New(env, info.version));
-    obj.Set("releaseDate", Napi::String::New(env, info.releaseDate));
-    obj.Set("biosCharacteristics", Napi::String::New(env, info.biosCharacteristics));
+    ForEachField<T>([&](const FieldDescriptor<T>& field) {
+        const auto& value = info.*field.member;
+        obj.Set(field.name, Napi::String::New(env, value.data(), value.size()));
+    });
     return obj;
 }
 
 /**
- * Convert SystemInfo struct to JavaScript object
+ * Convert a Snapshot or SnapshotView to JavaScript object (getAllInfo() shape)
  */
-Napi::Object SystemInfoToObject(Napi::Env env, const SystemInfo& info) {
+template <typename Str>
+Napi::Object SnapshotToObject(Napi::Env env, const BasicSnapshot<Str>& snapshot) {
     Napi::Object obj = Napi::Object::New(env);
-    obj.Set("manufacturer", Napi::String::New(env, info.manufacturer));
-    obj.Set("productName", Napi::String::New(env, info.productName));
-    obj.Set("serialNumber", Napi::String::New(env, info.serialNumber));
-    obj.Set("uuid", Napi::String::New(env, info.uuid));
-    obj.Set("skuNumber", Napi::String::New(env, info.skuNumber));
-    obj.Set("family", Napi::String::New(env, info.family));
-    obj.Set("wakeUpType", Napi::String::New(env, info.wakeUpType));
+    ForEachCategory([&](const char* category, const auto& info) {
+        obj.Set(category, InfoToObject(env, info));
+    }, snapshot);
     return obj;
 }
 
 /**
- * Convert BoardInfo struct to JavaScript object
+ * Fill an info struct from a JavaScript object. Missing properties are
+ * left empty; non-string values are converted with String().
  */
-Napi::Object BoardInfoToObject(Napi::Env env, const BoardInfo& info) {
+template <typename T>
+void ObjectToInfo(const Napi::Object& obj, T& info) {
+    ForEachField<T>([&](const FieldDescriptor<T>& field) {
+        Napi::Value value = obj.Get(field.name);
+        if (value.IsString()) {
+            info.*field.member = value.As<Napi::String>().Utf8Value();
+        } else if (value.IsNumber() || value.IsBoolean()) {
+            info.*field.member = value.ToString().Utf8Value();
+        }
+    });
+}
+
+/**
+ * Read a snapshot from a getAllInfo()-shaped object, its JSON string or
+ * a serializeSnapshot() Buffer. Returns false with a pending JavaScript
+ * exception on bad input.
+ */
+bool ValueToSnapshot(Napi::Env env, Napi::Value value, Snapshot& snapshot) {
+    if (value.IsBuffer()) {
+        Napi::Buffer<uint8_t> buffer = value.As<Napi::Buffer<uint8_t>>();
+        if (!DeserializeSnapshot(buffer.Data(), buffer.Length(), snapshot)) {
+            Napi::Error::New(env, "Invalid or unsupported serialized snapshot").ThrowAsJavaScriptException();
+            return false;
+        }
+        return true;
+    }
+    
+    if (value.IsString()) {
+        Napi::Object json = env.Global().Get("JSON").As<Napi::Object>();
+        value = json.Get("parse").As<Napi::Function>().Call(json, { value });
+        if (env.IsExceptionPending()) {
+            return false;
+        }
+    }
+    
+    if (!value.IsObject()) {
+        Napi::TypeError::New(env, "Expected a snapshot object, JSON string or Buffer").ThrowAsJavaScriptException();
+        return false;
+    }
+    
+    Napi::Object obj = value.As<Napi::Object>();
+    ForEachCategory([&](const char* category, auto& info) {
+        Napi::Value categoryValue = obj.Get(category);
+        if (categoryValue.IsObject()) {
+            ObjectToInfo(categoryValue.As<Napi::Object>(), info);
+        }
+    }, snapshot);
+    return true;
+}
+
+/**
+ * Convert CacheInfo struct to JavaScript object
+ */
+Napi::Object CacheInfoToObject(Napi::Env env, const CacheInfo& cache) {
     Napi::Object obj = Napi::Object::New(env);
-    obj.Set("manufacturer", Napi::String::New(env, info.manufacturer));
-    obj.Set("product", Napi::String::New(env, info.product));
-    obj.Set("version", Napi::String::New(env, info.version));
-    obj.Set("serialNumber", Napi::String::New(env, info.serialNumber));
-    obj.Set("assetTag", Napi::String::New(env, info.assetTag));
-    obj.Set("locationInChassis", Napi::String::New(env, info.locationInChassis));
+    obj.Set("socketDesignation", Napi::String::New(env, cache.socketDesignation));
+    obj.Set("level", Napi::Number::New(env, cache.level));
+    obj.Set("enabled", Napi::Boolean::New(env, cache.enabled));
+    obj.Set("location", Napi::String::New(env, cache.location));
+    obj.Set("operationalMode", Napi::String::New(env, cache.operationalMode));
+    obj.Set("cacheType", Napi::String::New(env, cache.cacheType));
+    obj.Set("associativity", Napi::String::New(env, cache.associativity));
+    obj.Set("errorCorrection", Napi::String::New(env, cache.errorCorrection));
+    obj.Set("installedSize", Napi::Number::New(env, static_cast<double>(cache.installedSize)));
+    obj.Set("maximumSize", Napi::Number::New(env, static_cast<double>(cache.maximumSize)));
     return obj;
 }
 
 /**
- * Convert ProcessorInfo struct to JavaScript object
+ * Convert ProcessorSocket struct to JavaScript object
  */
-Napi::Object ProcessorInfoToObject(Napi::Env env, const ProcessorInfo& info) {
+Napi::Object ProcessorSocketToObject(Napi::Env env, const ProcessorSocket& proc) {
     Napi::Object obj = Napi::Object::New(env);
-    obj.Set("manufacturer", Napi::String::New(env, info.manufacturer));
-    obj.Set("version", Napi::String::New(env, info.version));
-    obj.Set("socketDesignation", Napi::String::New(env, info.socketDesignation));
-    obj.Set("processorType", Napi::String::New(env, info.processorType));
-    obj.Set("processorFamily", Napi::String::New(env, info.processorFamily));
-    obj.Set("maxSpeed", Napi::String::New(env, info.maxSpeed));
-    obj.Set("currentSpeed", Napi::String::New(env, info.currentSpeed));
-    obj.Set("coreCount", Napi::String::New(env, info.coreCount));
-    obj.Set("threadCount", Napi::String::New(env, info.threadCount));
-    obj.Set("l2CacheSize", Napi::String::New(env, info.l2CacheSize));
-    obj.Set("l3CacheSize", Napi::String::New(env, info.l3CacheSize));
+    obj.Set("socketDesignation", Napi::String::New(env, proc.socketDesignation));
+    obj.Set("processorType", Napi::String::New(env, proc.processorType));
+    obj.Set("processorFamily", Napi::String::New(env, proc.processorFamily));
+    obj.Set("manufacturer", Napi::String::New(env, proc.manufacturer));
+    obj.Set("version", Napi::String::New(env, proc.version));
+    obj.Set("processorId", Napi::String::New(env, proc.processorId));
+    obj.Set("serialNumber", Napi::String::New(env, proc.serialNumber));
+    obj.Set("assetTag", Napi::String::New(env, proc.assetTag));
+    obj.Set("partNumber", Napi::String::New(env, proc.partNumber));
+    obj.Set("status", Napi::String::New(env, proc.status));
+    obj.Set("populated", Napi::Boolean::New(env, proc.populated));
+    obj.Set("voltage", Napi::Number::New(env, proc.voltage));
+    obj.Set("externalClock", Napi::Number::New(env, proc.externalClock));
+    obj.Set("maxSpeed", Napi::Number::New(env, proc.maxSpeed));
+    obj.Set("currentSpeed", Napi::Number::New(env, proc.currentSpeed));
+    obj.Set("coreCount", Napi::Number::New(env, proc.coreCount));
+    obj.Set("coreEnabled", Napi::Number::New(env, proc.coreEnabled));
+    obj.Set("threadCount", Napi::Number::New(env, proc.threadCount));
+    obj.Set("threadEnabled", Napi::Number::New(env, proc.threadEnabled));
+    
+    Napi::Array caches = Napi::Array::New(env, proc.caches.size());
+    for (size_t i = 0; i < proc.caches.size(); i++) {
+        caches.Set(static_cast<uint32_t>(i), CacheInfoToObject(env, proc.caches[i]));
+    }
+    obj.Set("caches", caches);
     return obj;
 }
 
 /**
- * Convert MemoryInfo struct to JavaScript object
+ * Convert SystemSlot struct to JavaScript object
  */
-Napi::Object MemoryInfoToObject(Napi::Env env, const MemoryInfo& info) {
+Napi::Object SystemSlotToObject(Napi::Env env, const SystemSlot& slot) {
     Napi::Object obj = Napi::Object::New(env);
-    obj.Set("totalPhysicalMemory", Napi::String::New(env, info.totalPhysicalMemory));
-    obj.Set("availablePhysicalMemory", Napi::String::New(env, info.availablePhysicalMemory));
-    obj.Set("totalVirtualMemory", Napi::String::New(env, info.totalVirtualMemory));
-    obj.Set("availableVirtualMemory", Napi::String::New(env, info.availableVirtualMemory));
-    obj.Set("memoryDevices", Napi::String::New(env, info.memoryDevices));
-    obj.Set("maxCapacity", Napi::String::New(env, info.maxCapacity));
+    obj.Set("designation", Napi::String::New(env, slot.designation));
+    obj.Set("slotType", Napi::String::New(env, slot.slotType));
+    obj.Set("dataBusWidth", Napi::String::New(env, slot.dataBusWidth));
+    obj.Set("physicalWidth", Napi::String::New(env, slot.physicalWidth));
+    obj.Set("currentUsage", Napi::String::New(env, slot.currentUsage));
+    obj.Set("slotLength", Napi::String::New(env, slot.slotLength));
+    obj.Set("slotId", Napi::Number::New(env, slot.slotId));
+    obj.Set("segment", Napi::Number::New(env, slot.segment));
+    obj.Set("bus", Napi::Number::New(env, slot.bus));
+    obj.Set("device", Napi::Number::New(env, slot.device));
+    obj.Set("function", Napi::Number::New(env, slot.function));
+    obj.Set("pciAddress", Napi::String::New(env, slot.pciAddress));
+    
+    Napi::Array peers = Napi::Array::New(env, slot.peers.size());
+    for (size_t i = 0; i < slot.peers.size(); i++) {
+        const SlotPeer& peer = slot.peers[i];
+        Napi::Object peerObj = Napi::Object::New(env);
+        peerObj.Set("segment", Napi::Number::New(env, peer.segment));
+        peerObj.Set("bus", Napi::Number::New(env, peer.bus));
+        peerObj.Set("device", Napi::Number::New(env, peer.device));
+        peerObj.Set("function", Napi::Number::New(env, peer.function));
+        peerObj.Set("dataBusWidth", Napi::Number::New(env, peer.dataBusWidth));
+        peers.Set(static_cast<uint32_t>(i), peerObj);
+    }
+    obj.Set("peers", peers);
     return obj;
 }
 
 /**
- * Convert ChassisInfo struct to JavaScript object
+ * Convert OnboardDevice struct to JavaScript object
  */
-Napi::Object ChassisInfoToObject(Napi::Env env, const ChassisInfo& info) {
+Napi::Object OnboardDeviceToObject(Napi::Env env, const OnboardDevice& device) {
     Napi::Object obj = Napi::Object::New(env);
-    obj.Set("manufacturer", Napi::String::New(env, info.manufacturer));
-    obj.Set("type", Napi::String::New(env, info.type));
-    obj.Set("version", Napi::String::New(env, info.version));
-    obj.Set("serialNumber", Napi::String::New(env, info.serialNumber));
-    obj.Set("assetTag", Napi::String::New(env, info.assetTag));
-    obj.Set("bootUpState", Napi::String::New(env, info.bootUpState));
-    obj.Set("powerSupplyState", Napi::String::New(env, info.powerSupplyState));
-    obj.Set("thermalState", Napi::String::New(env, info.thermalState));
+    obj.Set("referenceDesignation", Napi::String::New(env, device.referenceDesignation));
+    obj.Set("deviceType", Napi::String::New(env, device.deviceType));
+    obj.Set("enabled", Napi::Boolean::New(env, device.enabled));
+    obj.Set("instance", Napi::Number::New(env, device.instance));
+    obj.Set("segment", Napi::Number::New(env, device.segment));
+    obj.Set("bus", Napi::Number::New(env, device.bus));
+    obj.Set("device", Napi::Number::New(env, device.device));
+    obj.Set("function", Napi::Number::New(env, device.function));
+    obj.Set("pciAddress", Napi::String::New(env, device.pciAddress));
+    return obj;
+}
+
+/**
+ * Convert a list of CPU or node numbers to a JavaScript array
+ */
+Napi::Array NumbersToArray(Napi::Env env, const std::vector<uint32_t>& numbers) {
+    Napi::Array arr = Napi::Array::New(env, numbers.size());
+    for (size_t i = 0; i < numbers.size(); i++) {
+        arr.Set(static_cast<uint32_t>(i), Napi::Number::New(env, numbers[i]));
+    }
+    return arr;
+}
+
+/**
+ * Convert NumaNode struct to JavaScript object
+ */
+Napi::Object NumaNodeToObject(Napi::Env env, const NumaNode& node) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("id", Napi::Number::New(env, node.id));
+    obj.Set("cpus", NumbersToArray(env, node.cpus));
+    obj.Set("memTotal", Napi::Number::New(env, static_cast<double>(node.memTotal)));
+    obj.Set("memFree", Napi::Number::New(env, static_cast<double>(node.memFree)));
+    obj.Set("distances", NumbersToArray(env, node.distances));
+    
+    Napi::Array hugePages = Napi::Array::New(env, node.hugePages.size());
+    for (size_t i = 0; i < node.hugePages.size(); i++) {
+        const HugePagePool& pool = node.hugePages[i];
+        Napi::Object poolObj = Napi::Object::New(env);
+        poolObj.Set("pageSize", Napi::Number::New(env, static_cast<double>(pool.pageSize)));
+        poolObj.Set("total", Napi::Number::New(env, static_cast<double>(pool.total)));
+        poolObj.Set("free", Napi::Number::New(env, static_cast<double>(pool.free)));
+        poolObj.Set("surplus", Napi::Number::New(env, static_cast<double>(pool.surplus)));
+        hugePages.Set(static_cast<uint32_t>(i), poolObj);
+    }
+    obj.Set("hugePages", hugePages);
+    return obj;
+}
+
+/**
+ * Convert CacheInstance struct to JavaScript object
+ */
+Napi::Object CacheInstanceToObject(Napi::Env env, const CacheInstance& cache) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("level", Napi::Number::New(env, cache.level));
+    obj.Set("type", Napi::String::New(env, cache.type));
+    obj.Set("size", Napi::Number::New(env, static_cast<double>(cache.size)));
+    obj.Set("lineSize", Napi::Number::New(env, cache.lineSize));
+    obj.Set("ways", Napi::Number::New(env, cache.ways));
+    obj.Set("sets", Napi::Number::New(env, cache.sets));
+    obj.Set("cpus", NumbersToArray(env, cache.cpus));
+    
+    Napi::Uint32Array mask = Napi::Uint32Array::New(env, cache.cpuMask.size());
+    std::copy(cache.cpuMask.begin(), cache.cpuMask.end(), mask.Data());
+    obj.Set("cpuMask", mask);
+    return obj;
+}
+
+/**
+ * Convert EffectiveLimits struct to JavaScript object
+ */
+Napi::Object EffectiveLimitsToObject(Napi::Env env, const EffectiveLimits& limits) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("source", Napi::String::New(env, limits.source));
+    obj.Set("hostCpus", Napi::Number::New(env, limits.hostCpus));
+    obj.Set("cpus", NumbersToArray(env, limits.cpus));
+    obj.Set("cpuQuota", Napi::Number::New(env, limits.cpuQuota));
+    obj.Set("effectiveCpus", Napi::Number::New(env, limits.effectiveCpus));
+    obj.Set("hostMemory", Napi::Number::New(env, static_cast<double>(limits.hostMemory)));
+    obj.Set("memoryLimit", Napi::Number::New(env, static_cast<double>(limits.memoryLimit)));
+    obj.Set("memoryUsage", Napi::Number::New(env, static_cast<double>(limits.memoryUsage)));
+    obj.Set("effectiveMemory", Napi::Number::New(env, static_cast<double>(limits.effectiveMemory)));
+    return obj;
+}
+
+/**
+ * Convert ThermalSensor struct to JavaScript object
+ */
+Napi::Object ThermalSensorToObject(Napi::Env env, const ThermalSensor& sensor) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("source", Napi::String::New(env, sensor.source));
+    obj.Set("name", Napi::String::New(env, sensor.name));
+    obj.Set("label", Napi::String::New(env, sensor.label));
+    obj.Set("kind", Napi::String::New(env, sensor.kind));
+    obj.Set("package", Napi::Number::New(env, sensor.package));
+    obj.Set("core", Napi::Number::New(env, sensor.core));
+    obj.Set("warning", Napi::Number::New(env, sensor.warning));
+    obj.Set("critical", Napi::Number::New(env, sensor.critical));
+    return obj;
+}
+
+/**
+ * Convert VirtualizationInfo struct to JavaScript object
+ */
+Napi::Object VirtualizationToObject(Napi::Env env, const VirtualizationInfo& virt) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("virtualized", Napi::Boolean::New(env, virt.virtualized));
+    obj.Set("hypervisor", Napi::String::New(env, virt.hypervisor));
+    obj.Set("cpuidVendor", Napi::String::New(env, virt.cpuidVendor));
+    obj.Set("hypervisorBit", Napi::Boolean::New(env, virt.hypervisorBit));
+    obj.Set("source", Napi::String::New(env, virt.source));
+    return obj;
+}
+
+/**
+ * Convert a raw SMBIOS structure to JavaScript object
+ */
+Napi::Object StructureToObject(Napi::Env env, const Table& table, const Structure& s) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("type", Napi::Number::New(env, s.type));
+    obj.Set("handle", Napi::Number::New(env, s.handle));
+    obj.Set("length", Napi::Number::New(env, s.length));
+    obj.Set("data", Napi::Buffer<uint8_t>::Copy(env, table.Data(s), s.length));
+    
+    std::vector<std::string> strings = table.Strings(s);
+    Napi::Array arr = Napi::Array::New(env, strings.size());
+    for (size_t i = 0; i < strings.size(); i++) {
+        arr.Set(static_cast<uint32_t>(i), Napi::String::New(env, strings[i]));
+    }
+    obj.Set("strings", arr);
     return obj;
 }
 
@@ -100,8 +314,8 @@ Napi::Value GetBiosInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        BiosInfo biosInfo = GetBiosInfo();
-        return BiosInfoToObject(env, biosInfo);
+        SnapshotRef snapshot(CATEGORY_BIOS);
+        return InfoToObject(env, snapshot.View().bios);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -115,8 +329,8 @@ Napi::Value GetSystemInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        SystemInfo systemInfo = GetSystemInfo();
-        return SystemInfoToObject(env, systemInfo);
+        SnapshotRef snapshot(CATEGORY_SYSTEM);
+        return InfoToObject(env, snapshot.View().system);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -130,8 +344,8 @@ Napi::Value GetBoardInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        BoardInfo boardInfo = GetBoardInfo();
-        return BoardInfoToObject(env, boardInfo);
+        SnapshotRef snapshot(CATEGORY_BOARD);
+        return InfoToObject(env, snapshot.View().board);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -145,8 +359,8 @@ Napi::Value GetProcessorInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        ProcessorInfo procInfo = GetProcessorInfo();
-        return ProcessorInfoToObject(env, procInfo);
+        SnapshotRef snapshot(CATEGORY_PROCESSOR);
+        return InfoToObject(env, snapshot.View().processor);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -160,8 +374,8 @@ Napi::Value GetMemoryInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        MemoryInfo memInfo = GetMemoryInfo();
-        return MemoryInfoToObject(env, memInfo);
+        SnapshotRef snapshot(CATEGORY_MEMORY);
+        return InfoToObject(env, snapshot.View().memory);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -175,8 +389,8 @@ Napi::Value GetChassisInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        ChassisInfo chassisInfo = GetChassisInfo();
-        return ChassisInfoToObject(env, chassisInfo);
+        SnapshotRef snapshot(CATEGORY_CHASSIS);
+        return InfoToObject(env, snapshot.View().chassis);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
@@ -191,22 +405,372 @@ Napi::Value GetAllInfoWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-        Napi::Object result = Napi::Object::New(env);
+        SnapshotRef snapshot;
+        return SnapshotToObject(env, snapshot.View());
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: serializeSnapshot([snapshot])
+ * Encodes a snapshot (or the live system) in the compact binary format
+ */
+Napi::Value SerializeSnapshotWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        Snapshot snapshot;
+        if (info.Length() > 0 && !info[0].IsUndefined() && !info[0].IsNull()) {
+            if (!ValueToSnapshot(env, info[0], snapshot)) {
+                return env.Null();
+            }
+        } else {
+            snapshot = GetSnapshot();
+        }
+        
+        std::vector<uint8_t> bytes = SerializeSnapshot(snapshot);
+        return Napi::Buffer<uint8_t>::Copy(env, bytes.data(), bytes.size());
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: deserializeSnapshot(buffer)
+ * Decodes a serializeSnapshot() Buffer into the getAllInfo() shape
+ */
+Napi::Value DeserializeSnapshotWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsBuffer()) {
+        Napi::TypeError::New(env, "Expected a Buffer").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    try {
+        Snapshot snapshot;
+        if (!ValueToSnapshot(env, info[0], snapshot)) {
+            return env.Null();
+        }
+        return SnapshotToObject(env, snapshot);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: diffSnapshots(a[, b][, options])
+ * Compares two getAllInfo() snapshots (objects, JSON strings or
+ * serializeSnapshot() Buffers) and returns the changed fields. With `b`
+ * omitted or null, `a` is compared against the live system.
+ * `options.ignore` lists paths ("memory" or
+ * "memory.availablePhysicalMemory") to leave out.
+ */
+Napi::Value DiffSnapshotsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1) {
+        Napi::TypeError::New(env, "Expected a snapshot to compare").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    try {
+        Snapshot oldSnapshot;
+        if (!ValueToSnapshot(env, info[0], oldSnapshot)) {
+            return env.Null();
+        }
         
-        BiosInfo biosInfo = GetBiosInfo();
-        SystemInfo systemInfo = GetSystemInfo();
-        BoardInfo boardInfo = GetBoardInfo();
-        ProcessorInfo procInfo = GetProcessorInfo();
-        MemoryInfo memInfo = GetMemoryInfo();
-        ChassisInfo chassisInfo = GetChassisInfo();
+        Snapshot newSnapshot;
+        if (info.Length() > 1 && !info[1].IsUndefined() && !info[1].IsNull()) {
+            if (!ValueToSnapshot(env, info[1], newSnapshot)) {
+                return env.Null();
+            }
+        } else {
+            newSnapshot = GetSnapshot();
+        }
+        
+        std::vector<std::string> ignore;
+        if (info.Length() > 2 && info[2].IsObject()) {
+            Napi::Value ignoreValue = info[2].As<Napi::Object>().Get("ignore");
+            if (ignoreValue.IsArray()) {
+                Napi::Array arr = ignoreValue.As<Napi::Array>();
+                for (uint32_t i = 0; i < arr.Length(); i++) {
+                    ignore.push_back(arr.Get(i).ToString().Utf8Value());
+                }
+            }
+        }
+        
+        std::vector<FieldChange> changes = DiffSnapshots(oldSnapshot, newSnapshot);
+        Napi::Array result = Napi::Array::New(env);
+        uint32_t count = 0;
+        for (const FieldChange& change : changes) {
+            bool ignored = std::any_of(ignore.begin(), ignore.end(), [&](const std::string& path) {
+                return change.path == path ||
+                    (change.path.size() > path.size() && change.path.compare(0, path.size(), path) == 0 &&
+                     change.path[path.size()] == '.');
+            });
+            if (ignored) {
+                continue;
+            }
+            
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("path", Napi::String::New(env, change.path));
+            obj.Set("oldValue", Napi::String::New(env, change.oldValue));
+            obj.Set("newValue", Napi::String::New(env, change.newValue));
+            result.Set(count++, obj);
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: openSharedSnapshot([path])
+ * Maps (or creates) the shared snapshot of the static categories; the
+ * getters serve those categories from it afterwards
+ */
+Napi::Value OpenSharedSnapshotWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    std::string path = DEFAULT_SHARED_SNAPSHOT_PATH;
+    if (info.Length() > 0 && !info[0].IsUndefined() && !info[0].IsNull()) {
+        if (!info[0].IsString()) {
+            Napi::TypeError::New(env, "Expected snapshot path as a string").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        path = info[0].As<Napi::String>().Utf8Value();
+    }
+    
+    try {
+        SharedSnapshotInfo shared = OpenSharedSnapshot(path);
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("path", Napi::String::New(env, shared.path));
+        result.Set("bootId", Napi::String::New(env, shared.bootId));
+        result.Set("created", Napi::Boolean::New(env, shared.created));
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: closeSharedSnapshot()
+ */
+Napi::Value CloseSharedSnapshotWrapped(const Napi::CallbackInfo& info) {
+    CloseSharedSnapshot();
+    return info.Env().Undefined();
+}
+
+/**
+ * Node.js binding: getProcessors()
+ * Returns one record per processor socket
+ */
+Napi::Value GetProcessorsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<ProcessorSocket> sockets = GetProcessorSockets();
+        Napi::Array result = Napi::Array::New(env, sockets.size());
+        for (size_t i = 0; i < sockets.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), ProcessorSocketToObject(env, sockets[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getSystemSlots()
+ */
+Napi::Value GetSystemSlotsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<SystemSlot> slots = GetSystemSlots();
+        Napi::Array result = Napi::Array::New(env, slots.size());
+        for (size_t i = 0; i < slots.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), SystemSlotToObject(env, slots[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getOnboardDevices()
+ */
+Napi::Value GetOnboardDevicesWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<OnboardDevice> devices = GetOnboardDevices();
+        Napi::Array result = Napi::Array::New(env, devices.size());
+        for (size_t i = 0; i < devices.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), OnboardDeviceToObject(env, devices[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getNumaNodes()
+ */
+Napi::Value GetNumaNodesWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<NumaNode> nodes = GetNumaNodes();
+        Napi::Array result = Napi::Array::New(env, nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), NumaNodeToObject(env, nodes[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getCacheTopology()
+ */
+Napi::Value GetCacheTopologyWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<CacheInstance> caches = GetCacheTopology();
+        Napi::Array result = Napi::Array::New(env, caches.size());
+        for (size_t i = 0; i < caches.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), CacheInstanceToObject(env, caches[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getEffectiveLimits()
+ */
+Napi::Value GetEffectiveLimitsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        return EffectiveLimitsToObject(env, GetEffectiveLimits());
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getThermalSensors()
+ */
+Napi::Value GetThermalSensorsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<ThermalSensor> sensors = GetThermalSensors();
+        Napi::Array result = Napi::Array::New(env, sensors.size());
+        for (size_t i = 0; i < sensors.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), ThermalSensorToObject(env, sensors[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getVirtualization()
+ */
+Napi::Value GetVirtualizationWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        return VirtualizationToObject(env, GetVirtualization());
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getCpuFeatures()
+ * Returns the names of the detected CPU features
+ */
+Napi::Value GetCpuFeaturesWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    try {
+        std::vector<std::string> names = GetCpuFeatureNames();
+        Napi::Array result = Napi::Array::New(env, names.size());
+        for (size_t i = 0; i < names.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), Napi::String::New(env, names[i]));
+        }
+        return result;
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: hasCpuFeature(name)
+ */
+Napi::Value HasCpuFeatureWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected a feature name").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    return Napi::Boolean::New(env, HasCpuFeature(name));
+}
+
+/**
+ * Node.js binding: sampleCpuFrequencies([target])
+ * Returns a Float64Array of current MHz indexed by CPU number. When a
+ * Float64Array of sufficient length is passed it is filled and returned
+ * instead of allocating a new one.
+ */
+Napi::Value SampleCpuFrequenciesWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // Reused between calls, one buffer per JS thread
+    static thread_local std::vector<double> mhz;
+    
+    try {
+        SampleCpuFrequencies(mhz);
         
-        result.Set("bios", BiosInfoToObject(env, biosInfo));
-        result.Set("system", SystemInfoToObject(env, systemInfo));
-        result.Set("board", BoardInfoToObject(env, boardInfo));
-        result.Set("processor", ProcessorInfoToObject(env, procInfo));
-        result.Set("memory", MemoryInfoToObject(env, memInfo));
-        result.Set("chassis", ChassisInfoToObject(env, chassisInfo));
+        Napi::Float64Array result;
+        if (info.Length() > 0 && info[0].IsTypedArray() &&
+            info[0].As<Napi::TypedArray>().TypedArrayType() == napi_float64_array &&
+            info[0].As<Napi::Float64Array>().ElementLength() >= mhz.size()) {
+            result = info[0].As<Napi::Float64Array>();
+        } else {
+            result = Napi::Float64Array::New(env, mhz.size());
+        }
         
+        std::copy(mhz.begin(), mhz.end(), result.Data());
         return result;
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
@@ -214,6 +778,183 @@ Napi::Value GetAllInfoWrapped(const Napi::CallbackInfo& info) {
     }
 }
 
+/**
+ * Float64Array argument of at least `length` elements, or throw a TypeError
+ */
+bool Float64ArrayArg(const Napi::CallbackInfo& info, size_t length, Napi::Float64Array& target) {
+    if (info.Length() < 1 || !info[0].IsTypedArray() ||
+        info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float64_array ||
+        info[0].As<Napi::Float64Array>().ElementLength() < length) {
+        Napi::TypeError::New(info.Env(), "Expected a Float64Array of at least " +
+                             std::to_string(length) + " elements").ThrowAsJavaScriptException();
+        return false;
+    }
+    target = info[0].As<Napi::Float64Array>();
+    return true;
+}
+
+/**
+ * Node.js binding: fillMemoryStats(target)
+ * Writes total, free, available, buffers, cached, swapTotal and swapFree
+ * (bytes) to target[0..6]
+ */
+Napi::Value FillMemoryStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    Napi::Float64Array target;
+    if (!Float64ArrayArg(info, MEMORY_STAT_COUNT, target)) {
+        return env.Undefined();
+    }
+    
+    try {
+        double stats[MEMORY_STAT_COUNT];
+        SampleMemoryStats(stats);
+        std::copy(std::begin(stats), std::end(stats), target.Data());
+        return env.Undefined();
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: fillCpuStats(target)
+ * Writes the CPU count and system load to target[0..1], then MHz and load
+ * of CPU n to target[2 + 2n] and target[3 + 2n] for as many CPUs as fit
+ */
+Napi::Value FillCpuStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // Reused between calls, one set per JS thread; the load counters are
+    // separate from the OpenMetrics renderer's
+    static thread_local std::vector<double> mhz;
+    static thread_local CpuLoadState loadState;
+    static thread_local std::vector<double> load;
+    
+    Napi::Float64Array target;
+    if (!Float64ArrayArg(info, 2, target)) {
+        return env.Undefined();
+    }
+    
+    try {
+        double systemLoad = SampleCpuLoads(loadState, load);
+        SampleCpuFrequencies(mhz);
+        
+        size_t count = std::max(mhz.size(), load.size());
+        double* out = target.Data();
+        out[0] = static_cast<double>(count);
+        out[1] = systemLoad;
+        size_t fit = std::min(count, (target.ElementLength() - 2) / 2);
+        for (size_t cpu = 0; cpu < fit; cpu++) {
+            out[2 + 2 * cpu] = cpu < mhz.size() ? mhz[cpu] : NAN;
+            out[3 + 2 * cpu] = cpu < load.size() ? load[cpu] : NAN;
+        }
+        return env.Undefined();
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: fillTemperatures(target)
+ * Writes the sensor count and the thermal state (0 Unknown, 1 Safe,
+ * 2 Warning, 3 Critical) to target[0..1], then °C of sensor n to
+ * target[2 + n] for as many sensors as fit
+ */
+Napi::Value FillTemperaturesWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // Reused between calls, one buffer per JS thread
+    static thread_local std::vector<double> celsius;
+    
+    Napi::Float64Array target;
+    if (!Float64ArrayArg(info, 2, target)) {
+        return env.Undefined();
+    }
+    
+    try {
+        ThermalState state = SampleTemperatures(celsius);
+        
+        double* out = target.Data();
+        out[0] = static_cast<double>(celsius.size());
+        out[1] = static_cast<double>(state);
+        size_t fit = std::min(celsius.size(), target.ElementLength() - 2);
+        std::copy(celsius.begin(), celsius.begin() + fit, out + 2);
+        return env.Undefined();
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getOpenMetrics()
+ * Returns the OpenMetrics text exposition as a string
+ */
+Napi::Value GetOpenMetricsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    // Reused between scrapes, one buffer per JS thread
+    static thread_local std::string buffer;
+    
+    try {
+        RenderOpenMetrics(buffer);
+        return Napi::String::New(env, buffer);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * Node.js binding: getByType(type)
+ * Returns all raw structures of the given SMBIOS type
+ */
+Napi::Value GetByTypeWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected SMBIOS structure type as a number").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    uint32_t type = info[0].As<Napi::Number>().Uint32Value();
+    if (type > 255) {
+        Napi::RangeError::New(env, "SMBIOS structure type must be between 0 and 255").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    const Table& table = GetTable();
+    Napi::Array result = Napi::Array::New(env, table.TypeCount(static_cast<uint8_t>(type)));
+    uint32_t i = 0;
+    for (const Structure* s = table.TypeBegin(static_cast<uint8_t>(type)); s != table.TypeEnd(static_cast<uint8_t>(type)); ++s) {
+        result.Set(i++, StructureToObject(env, table, *s));
+    }
+    return result;
+}
+
+/**
+ * Node.js binding: findByHandle(handle)
+ * Returns the raw structure with the given handle, or null
+ */
+Napi::Value FindByHandleWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected SMBIOS handle as a number").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    uint32_t handle = info[0].As<Napi::Number>().Uint32Value();
+    const Table& table = GetTable();
+    const Structure* s = handle <= 0xFFFF ? table.FindByHandle(static_cast<uint16_t>(handle)) : nullptr;
+    if (!s) {
+        return env.Null();
+    }
+    return StructureToObject(env, table, *s);
+}
+
 /**
  * Initialize the Node.js addon
  */
@@ -253,6 +994,116 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
         Napi::Function::New(env, GetAllInfoWrapped)
     );
     
+    exports.Set(
+        Napi::String::New(env, "diffSnapshots"),
+        Napi::Function::New(env, DiffSnapshotsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "serializeSnapshot"),
+        Napi::Function::New(env, SerializeSnapshotWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "deserializeSnapshot"),
+        Napi::Function::New(env, DeserializeSnapshotWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "openSharedSnapshot"),
+        Napi::Function::New(env, OpenSharedSnapshotWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "closeSharedSnapshot"),
+        Napi::Function::New(env, CloseSharedSnapshotWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getProcessors"),
+        Napi::Function::New(env, GetProcessorsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getSystemSlots"),
+        Napi::Function::New(env, GetSystemSlotsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getOnboardDevices"),
+        Napi::Function::New(env, GetOnboardDevicesWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getNumaNodes"),
+        Napi::Function::New(env, GetNumaNodesWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getCacheTopology"),
+        Napi::Function::New(env, GetCacheTopologyWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getEffectiveLimits"),
+        Napi::Function::New(env, GetEffectiveLimitsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getThermalSensors"),
+        Napi::Function::New(env, GetThermalSensorsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getVirtualization"),
+        Napi::Function::New(env, GetVirtualizationWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getCpuFeatures"),
+        Napi::Function::New(env, GetCpuFeaturesWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "hasCpuFeature"),
+        Napi::Function::New(env, HasCpuFeatureWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "sampleCpuFrequencies"),
+        Napi::Function::New(env, SampleCpuFrequenciesWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "fillMemoryStats"),
+        Napi::Function::New(env, FillMemoryStatsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "fillCpuStats"),
+        Napi::Function::New(env, FillCpuStatsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "fillTemperatures"),
+        Napi::Function::New(env, FillTemperaturesWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getOpenMetrics"),
+        Napi::Function::New(env, GetOpenMetricsWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "getByType"),
+        Napi::Function::New(env, GetByTypeWrapped)
+    );
+    
+    exports.Set(
+        Napi::String::New(env, "findByHandle"),
+        Napi::Function::New(env, FindByHandleWrapped)
+    );
+    
     return exports;
 }
 
@@ -0,0 +1,232 @@
+/**
+ * smbios-cli - print SMBIOS information without starting a Node.js runtime
+ *
+ *   smbios-cli [--json] [--shared[=PATH]] [category[.field] ...]
+ *
+ * With no selector every category is printed. A single field prints just
+ * its value, which is what shell scripts usually want:
+ *
+ *   uuid=$(smbios-cli system.uuid)
+ */
+
+#include "../smbios.h"
+#include "../smbios_fields.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace smbios;
+
+namespace {
+
+struct Selector {
+    std::string category;
+    std::string field;     // Empty for the whole category
+};
+
+const struct {
+    const char* name;
+    unsigned mask;
+} CATEGORIES[] = {
+    { "bios", CATEGORY_BIOS },
+    { "system", CATEGORY_SYSTEM },
+    { "board", CATEGORY_BOARD },
+    { "processor", CATEGORY_PROCESSOR },
+    { "memory", CATEGORY_MEMORY },
+    { "chassis", CATEGORY_CHASSIS },
+};
+
+unsigned CategoryMask(const std::string& name) {
+    for (const auto& category : CATEGORIES) {
+        if (name == category.name) {
+            return category.mask;
+        }
+    }
+    return 0;
+}
+
+bool HasField(const std::string& category, const std::string& field) {
+    bool found = false;
+    Snapshot snapshot;
+    ForEachCategory([&](const char* name, auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        if (category == name) {
+            ForEachField<Info>([&](const FieldDescriptor<Info>& descriptor) {
+                found = found || field == descriptor.name;
+            });
+        }
+    }, snapshot);
+    return found;
+}
+
+void PrintJsonString(const std::string& value) {
+    putchar('"');
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"': fputs("\\\"", stdout); break;
+            case '\\': fputs("\\\\", stdout); break;
+            case '\n': fputs("\\n", stdout); break;
+            case '\r': fputs("\\r", stdout); break;
+            case '\t': fputs("\\t", stdout); break;
+            default:
+                if (c < 0x20) {
+                    printf("\\u%04x", c);
+                } else {
+                    putchar(c);
+                }
+        }
+    }
+    putchar('"');
+}
+
+bool Selected(const std::vector<Selector>& selectors, const char* category, const char* field) {
+    if (selectors.empty()) {
+        return true;
+    }
+    for (const Selector& selector : selectors) {
+        if (selector.category == category && (selector.field.empty() || selector.field == field)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PrintText(const Snapshot& snapshot, const std::vector<Selector>& selectors) {
+    // A single field prints the bare value
+    bool bare = selectors.size() == 1 && !selectors[0].field.empty();
+
+    ForEachCategory([&](const char* category, const auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+            if (!Selected(selectors, category, field.name)) {
+                return;
+            }
+            if (bare) {
+                printf("%s\n", (info.*field.member).c_str());
+            } else {
+                printf("%s.%s=%s\n", category, field.name, (info.*field.member).c_str());
+            }
+        });
+    }, snapshot);
+}
+
+void PrintJson(const Snapshot& snapshot, const std::vector<Selector>& selectors) {
+    bool bare = selectors.size() == 1 && !selectors[0].field.empty();
+    bool firstCategory = true;
+
+    if (!bare) {
+        putchar('{');
+    }
+    ForEachCategory([&](const char* category, const auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        bool firstField = true;
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+            if (!Selected(selectors, category, field.name)) {
+                return;
+            }
+            if (bare) {
+                PrintJsonString(info.*field.member);
+                return;
+            }
+            if (firstField) {
+                printf("%s\"%s\":{", firstCategory ? "" : ",", category);
+                firstCategory = false;
+            }
+            printf("%s\"%s\":", firstField ? "" : ",", field.name);
+            PrintJsonString(info.*field.member);
+            firstField = false;
+        });
+        if (!firstField) {
+            putchar('}');
+        }
+    }, snapshot);
+    if (!bare) {
+        putchar('}');
+    }
+    putchar('\n');
+}
+
+void PrintUsage(FILE* out) {
+    fputs(
+        "Usage: smbios-cli [--json] [--shared[=PATH]] [category[.field] ...]\n"
+        "\n"
+        "Categories: bios, system, board, processor, memory, chassis\n"
+        "\n"
+        "Options:\n"
+        "  --json           Print JSON instead of category.field=value lines\n"
+        "  --shared[=PATH]  Read static categories from the shared snapshot\n"
+        "                   (default ", out);
+    fputs(DEFAULT_SHARED_SNAPSHOT_PATH, out);
+    fputs(")\n"
+        "  --help           Show this help\n", out);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool json = false;
+    const char* sharedPath = nullptr;
+    std::vector<Selector> selectors;
+    unsigned categories = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(arg, "--shared") == 0) {
+            sharedPath = DEFAULT_SHARED_SNAPSHOT_PATH;
+        } else if (std::strncmp(arg, "--shared=", 9) == 0) {
+            sharedPath = arg + 9;
+        } else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            PrintUsage(stdout);
+            return 0;
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "smbios-cli: unknown option %s\n", arg);
+            PrintUsage(stderr);
+            return 2;
+        } else {
+            Selector selector;
+            const char* dot = std::strchr(arg, '.');
+            selector.category = dot ? std::string(arg, dot - arg) : std::string(arg);
+            selector.field = dot ? std::string(dot + 1) : std::string();
+
+            unsigned mask = CategoryMask(selector.category);
+            if (mask == 0) {
+                fprintf(stderr, "smbios-cli: unknown category '%s'\n", selector.category.c_str());
+                return 1;
+            }
+            if (!selector.field.empty() && !HasField(selector.category, selector.field)) {
+                fprintf(stderr, "smbios-cli: unknown field '%s'\n", arg);
+                return 1;
+            }
+            categories |= mask;
+            selectors.push_back(selector);
+        }
+    }
+
+    try {
+        if (sharedPath) {
+            OpenSharedSnapshot(sharedPath);
+        }
+    } catch (const std::exception& e) {
+        // Fall back to reading the live system
+        fprintf(stderr, "smbios-cli: %s\n", e.what());
+    }
+
+    try {
+        // Only collect what was asked for
+        Snapshot snapshot = GetSnapshot(selectors.empty() ? CATEGORY_ALL : categories);
+        if (json) {
+            PrintJson(snapshot, selectors);
+        } else {
+            PrintText(snapshot, selectors);
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "smbios-cli: %s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
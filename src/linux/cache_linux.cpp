@@ -0,0 +1,128 @@
+#include "../smbios_common.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+const std::string CPU_PATH = "/sys/devices/system/cpu/";
+
+/**
+ * Parse a cache size such as "32K" or "1M" into bytes
+ */
+uint64_t ParseCacheSize(const std::string& text) {
+    char* end = nullptr;
+    uint64_t value = std::strtoull(text.c_str(), &end, 10);
+    switch (*end) {
+        case 'K': return value << 10;
+        case 'M': return value << 20;
+        case 'G': return value << 30;
+        default: return value;
+    }
+}
+
+uint32_t ReadUint32(const std::string& path) {
+    return static_cast<uint32_t>(std::strtoul(ReadFile(path).c_str(), nullptr, 10));
+}
+
+/**
+ * Parse a kernel CPU bitmap such as "00000000,000000f0" (32-bit hex
+ * words, most significant first) into CPU numbers
+ */
+std::vector<uint32_t> ParseCpuMap(const std::string& map) {
+    std::vector<uint32_t> cpus;
+    uint32_t bit = 0;
+    for (size_t i = map.size(); i-- > 0;) {
+        char c = map[i];
+        if (c == ',') {
+            continue;
+        }
+        uint32_t nibble = std::isdigit(static_cast<unsigned char>(c)) ? c - '0'
+                        : std::isxdigit(static_cast<unsigned char>(c)) ? (c | 0x20) - 'a' + 10
+                        : 0;
+        for (uint32_t b = 0; b < 4; b++, bit++) {
+            if (nibble & (1u << b)) {
+                cpus.push_back(bit);
+            }
+        }
+    }
+    return cpus;
+}
+
+/**
+ * CPUs sharing a cache: shared_cpu_list, else shared_cpu_map (missing
+ * on some ARM kernels), else only the CPU itself
+ */
+std::vector<uint32_t> SharedCpus(const std::string& indexPath, uint32_t cpu) {
+    std::vector<uint32_t> cpus = ParseCpuList(ReadFile(indexPath + "shared_cpu_list"));
+    if (cpus.empty()) {
+        cpus = ParseCpuMap(ReadFile(indexPath + "shared_cpu_map"));
+    }
+    if (cpus.empty()) {
+        cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+std::vector<uint32_t> CpuMask(const std::vector<uint32_t>& cpus) {
+    std::vector<uint32_t> mask(cpus.empty() ? 0 : cpus.back() / 32 + 1, 0);
+    for (uint32_t cpu : cpus) {
+        mask[cpu / 32] |= 1u << (cpu % 32);
+    }
+    return mask;
+}
+
+} // namespace
+
+std::vector<CacheInstance> GetCacheTopology() {
+    std::vector<CacheInstance> caches;
+
+    // Every CPU lists all the caches it uses; an instance is identified by
+    // its level, type and the set of CPUs sharing it
+    std::set<std::tuple<std::string, std::string, std::vector<uint32_t>>> seen;
+    for (uint32_t cpu : ParseCpuList(ReadFile(CPU_PATH + "online"))) {
+        std::string cpuPath = CPU_PATH + "cpu" + std::to_string(cpu) + "/cache/";
+        for (uint32_t index = 0;; index++) {
+            std::string indexPath = cpuPath + "index" + std::to_string(index) + "/";
+            std::string level = ReadFile(indexPath + "level");
+            if (level.empty()) {
+                break;
+            }
+
+            std::string type = ReadFile(indexPath + "type");
+            std::vector<uint32_t> shared = SharedCpus(indexPath, cpu);
+            if (!seen.emplace(level, type, shared).second) {
+                continue;
+            }
+
+            CacheInstance cache;
+            cache.level = static_cast<uint8_t>(std::strtoul(level.c_str(), nullptr, 10));
+            cache.type = type;
+            cache.size = ParseCacheSize(ReadFile(indexPath + "size"));
+            cache.lineSize = ReadUint32(indexPath + "coherency_line_size");
+            cache.ways = ReadUint32(indexPath + "ways_of_associativity");
+            cache.sets = ReadUint32(indexPath + "number_of_sets");
+            cache.cpus = std::move(shared);
+            cache.cpuMask = CpuMask(cache.cpus);
+            caches.push_back(std::move(cache));
+        }
+    }
+
+    std::sort(caches.begin(), caches.end(), [](const CacheInstance& a, const CacheInstance& b) {
+        return std::tie(a.level, a.type, a.cpus) < std::tie(b.level, b.type, b.cpus);
+    });
+    return caches;
+}
+
+} // namespace smbios
+
+#endif // __linux__
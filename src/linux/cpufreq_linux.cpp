@@ -0,0 +1,79 @@
+#include "../smbios_common.h"
+#include "sysfs_file.h"
+
+#ifdef __linux__
+
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+const std::string CPU_PATH = "/sys/devices/system/cpu/";
+
+/**
+ * Holds one scaling_cur_freq (or cpuinfo_cur_freq) descriptor per online
+ * CPU. The online mask is re-read on every sample and the descriptors are
+ * only reopened when it changes (CPU hotplug). Results are indexed by CPU
+ * number; offline CPUs read as NaN.
+ */
+class FrequencySampler {
+public:
+    FrequencySampler() : online(CPU_PATH + "online") {}
+
+    void Sample(std::vector<double>& mhz) {
+        char mask[4096];
+        if (online.Read(mask, sizeof(mask)) < 0) {
+            mhz.clear();
+            return;
+        }
+        if (onlineMask != mask) {
+            Reopen(mask);
+        }
+
+        mhz.assign(cpus.empty() ? 0 : cpus.back() + 1, NAN);
+        for (size_t i = 0; i < files.size(); i++) {
+            int64_t khz = 0;
+            if (files[i].ReadInt64(khz)) {
+                mhz[cpus[i]] = khz / 1000.0;
+            }
+        }
+    }
+
+private:
+    void Reopen(const char* mask) {
+        onlineMask = mask;
+        files.clear();
+        cpus = ParseCpuList(onlineMask);
+        for (uint32_t cpu : cpus) {
+            std::string base = CPU_PATH + "cpu" + std::to_string(cpu) + "/cpufreq/";
+            SysfsFile file(base + "scaling_cur_freq");
+            if (!file.IsOpen()) {
+                file = SysfsFile(base + "cpuinfo_cur_freq");
+            }
+            files.push_back(std::move(file));
+        }
+    }
+
+    SysfsFile online;
+    std::string onlineMask;
+    std::vector<uint32_t> cpus;
+    std::vector<SysfsFile> files;
+};
+
+std::mutex samplerMutex;
+
+} // namespace
+
+void SampleCpuFrequencies(std::vector<double>& mhz) {
+    static FrequencySampler sampler;
+    std::lock_guard<std::mutex> lock(samplerMutex);
+    sampler.Sample(mhz);
+}
+
+} // namespace smbios
+
+#endif // __linux__
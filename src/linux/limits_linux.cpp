@@ -0,0 +1,229 @@
+#include "../smbios_common.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sched.h>
+#include <string>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+const std::string CGROUP_ROOT = "/sys/fs/cgroup/";
+
+/**
+ * v1 values at or above this mean "no limit" (PAGE_COUNTER_MAX rounded
+ * to pages, as written by the kernel)
+ */
+const uint64_t CGROUP1_UNLIMITED = 0x7FFFFFFFFFFFF000ull;
+
+/**
+ * Path of the process's cgroup for a controller ("" selects the v2
+ * unified hierarchy), from /proc/self/cgroup
+ */
+bool FindCgroupPath(const std::string& controller, std::string& path) {
+    std::ifstream file("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t first = line.find(':');
+        size_t second = line.find(':', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            continue;
+        }
+
+        std::string controllers = line.substr(first + 1, second - first - 1);
+        bool match = controller.empty()
+            ? controllers.empty()
+            : ("," + controllers + ",").find("," + controller + ",") != std::string::npos;
+        if (match) {
+            path = line.substr(second + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Directories from the process's cgroup up to the hierarchy root. Inside
+ * a cgroup namespace or a container mount the recorded path may not exist
+ * under mountPoint, in which case only the mount root is used.
+ */
+std::vector<std::string> CgroupChain(const std::string& mountPoint, std::string path) {
+    std::vector<std::string> chain;
+    if (!FileExists(mountPoint + path)) {
+        path = "/";
+    }
+    while (true) {
+        chain.push_back(mountPoint + path);
+        if (path.empty() || path == "/") {
+            break;
+        }
+        size_t slash = path.find_last_of('/');
+        path = slash == 0 || slash == std::string::npos ? "/" : path.substr(0, slash);
+    }
+    return chain;
+}
+
+uint64_t ReadUint64(const std::string& path, bool& ok) {
+    std::string text = ReadFile(path);
+    char* end = nullptr;
+    uint64_t value = std::strtoull(text.c_str(), &end, 10);
+    ok = !text.empty() && end != text.c_str();
+    return value;
+}
+
+/**
+ * Keep the smaller of two limits where 0 means unlimited
+ */
+template <typename T>
+T MinLimit(T current, T candidate) {
+    if (candidate <= 0) {
+        return current;
+    }
+    return current <= 0 ? candidate : std::min(current, candidate);
+}
+
+std::vector<uint32_t> Intersect(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    std::vector<uint32_t> result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+/**
+ * memory.max / cpu.max / cpuset.cpus.effective across the v2 hierarchy
+ */
+bool ReadCgroup2(EffectiveLimits& limits) {
+    std::string path;
+    if (!FileExists(CGROUP_ROOT + "cgroup.controllers") || !FindCgroupPath("", path)) {
+        return false;
+    }
+
+    std::vector<std::string> chain = CgroupChain(CGROUP_ROOT, path);
+    bool ok = false;
+    limits.memoryUsage = ReadUint64(chain.front() + "/memory.current", ok);
+
+    // The tightest ancestor wins
+    for (const std::string& dir : chain) {
+        uint64_t memoryMax = ReadUint64(dir + "/memory.max", ok);
+        if (ok) {
+            limits.memoryLimit = MinLimit(limits.memoryLimit, memoryMax);
+        }
+
+        std::string cpuMax = ReadFile(dir + "/cpu.max");
+        double quota = 0;
+        double period = 0;
+        if (std::sscanf(cpuMax.c_str(), "%lf %lf", &quota, &period) == 2 && period > 0) {
+            limits.cpuQuota = MinLimit(limits.cpuQuota, quota / period);
+        }
+    }
+
+    std::string cpuset = ReadFile(chain.front() + "/cpuset.cpus.effective");
+    if (!cpuset.empty()) {
+        limits.cpus = Intersect(limits.cpus, ParseCpuList(cpuset));
+    }
+
+    limits.source = "cgroup2";
+    return true;
+}
+
+/**
+ * The same limits from the v1 memory, cpu and cpuset hierarchies
+ */
+bool ReadCgroup1(EffectiveLimits& limits) {
+    bool found = false;
+    bool ok = false;
+    std::string path;
+
+    if (FindCgroupPath("memory", path)) {
+        std::vector<std::string> chain = CgroupChain(CGROUP_ROOT + "memory", path);
+        limits.memoryUsage = ReadUint64(chain.front() + "/memory.usage_in_bytes", ok);
+        for (const std::string& dir : chain) {
+            uint64_t limit = ReadUint64(dir + "/memory.limit_in_bytes", ok);
+            if (ok && limit < CGROUP1_UNLIMITED) {
+                limits.memoryLimit = MinLimit(limits.memoryLimit, limit);
+            }
+        }
+        found = true;
+    }
+
+    if (FindCgroupPath("cpu", path)) {
+        std::string mount = FileExists(CGROUP_ROOT + "cpu,cpuacct") ? CGROUP_ROOT + "cpu,cpuacct" : CGROUP_ROOT + "cpu";
+        for (const std::string& dir : CgroupChain(mount, path)) {
+            double quota = std::strtod(ReadFile(dir + "/cpu.cfs_quota_us").c_str(), nullptr);
+            double period = std::strtod(ReadFile(dir + "/cpu.cfs_period_us").c_str(), nullptr);
+            if (quota > 0 && period > 0) {
+                limits.cpuQuota = MinLimit(limits.cpuQuota, quota / period);
+            }
+        }
+        found = true;
+    }
+
+    if (FindCgroupPath("cpuset", path)) {
+        std::string dir = CgroupChain(CGROUP_ROOT + "cpuset", path).front();
+        std::string cpuset = ReadFile(dir + "/cpuset.effective_cpus");
+        if (cpuset.empty()) {
+            cpuset = ReadFile(dir + "/cpuset.cpus");
+        }
+        if (!cpuset.empty()) {
+            limits.cpus = Intersect(limits.cpus, ParseCpuList(cpuset));
+        }
+        found = true;
+    }
+
+    if (found) {
+        limits.source = "cgroup1";
+    }
+    return found;
+}
+
+} // namespace
+
+EffectiveLimits GetEffectiveLimits() {
+    EffectiveLimits limits;
+
+    std::vector<uint32_t> online = ParseCpuList(ReadFile("/sys/devices/system/cpu/online"));
+    limits.hostCpus = static_cast<uint32_t>(online.size());
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                limits.cpus.push_back(cpu);
+            }
+        }
+    } else {
+        limits.cpus = online;
+    }
+
+    std::string meminfo = ReadFile("/proc/meminfo");
+    const char* memTotal = std::strstr(meminfo.c_str(), "MemTotal:");
+    if (memTotal) {
+        limits.hostMemory = std::strtoull(memTotal + std::strlen("MemTotal:"), nullptr, 10) * 1024;
+    }
+
+    if (!ReadCgroup2(limits)) {
+        ReadCgroup1(limits);
+    }
+
+    limits.effectiveCpus = static_cast<uint32_t>(limits.cpus.size());
+    if (limits.cpuQuota > 0) {
+        uint32_t quotaCpus = static_cast<uint32_t>(std::max(1.0, std::ceil(limits.cpuQuota)));
+        limits.effectiveCpus = std::min(limits.effectiveCpus, quotaCpus);
+    }
+    limits.effectiveMemory = MinLimit(limits.hostMemory, limits.memoryLimit);
+
+    return limits;
+}
+
+} // namespace smbios
+
+#endif // __linux__
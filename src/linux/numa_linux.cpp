@@ -0,0 +1,100 @@
+#include "../smbios_common.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+const std::string NODE_PATH = "/sys/devices/system/node/";
+
+/**
+ * Value of a "Node N Key:   1234 kB" line of a node meminfo file, in bytes
+ */
+uint64_t NodeMeminfoBytes(const std::string& meminfo, const char* key) {
+    const char* p = std::strstr(meminfo.c_str(), key);
+    if (!p) {
+        return 0;
+    }
+    return std::strtoull(p + std::strlen(key), nullptr, 10) * 1024;
+}
+
+uint64_t ReadCount(const std::string& path) {
+    return std::strtoull(ReadFile(path).c_str(), nullptr, 10);
+}
+
+std::vector<uint32_t> ParseDistances(const std::string& text) {
+    std::vector<uint32_t> distances;
+    const char* p = text.c_str();
+    char* end = nullptr;
+    for (unsigned long value = std::strtoul(p, &end, 10); end != p; value = std::strtoul(p, &end, 10)) {
+        distances.push_back(static_cast<uint32_t>(value));
+        p = end;
+    }
+    return distances;
+}
+
+/**
+ * One pool per hugepages-<size>kB directory, smallest page size first
+ */
+std::vector<HugePagePool> ReadHugePages(const std::string& nodePath) {
+    std::vector<HugePagePool> pools;
+    std::string dirPath = nodePath + "hugepages/";
+    DIR* dir = opendir(dirPath.c_str());
+    if (!dir) {
+        return pools;
+    }
+
+    const char prefix[] = "hugepages-";
+    while (struct dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, prefix, sizeof(prefix) - 1) != 0) {
+            continue;
+        }
+        std::string poolPath = dirPath + entry->d_name + "/";
+        HugePagePool pool;
+        pool.pageSize = std::strtoull(entry->d_name + sizeof(prefix) - 1, nullptr, 10) * 1024;
+        pool.total = ReadCount(poolPath + "nr_hugepages");
+        pool.free = ReadCount(poolPath + "free_hugepages");
+        pool.surplus = ReadCount(poolPath + "surplus_hugepages");
+        pools.push_back(pool);
+    }
+    closedir(dir);
+
+    std::sort(pools.begin(), pools.end(),
+        [](const HugePagePool& a, const HugePagePool& b) { return a.pageSize < b.pageSize; });
+    return pools;
+}
+
+} // namespace
+
+std::vector<NumaNode> GetNumaNodes() {
+    std::vector<NumaNode> nodes;
+
+    // Kernels built without CONFIG_NUMA have no node directory at all
+    for (uint32_t id : ParseCpuList(ReadFile(NODE_PATH + "online"))) {
+        std::string nodePath = NODE_PATH + "node" + std::to_string(id) + "/";
+        std::string meminfo = ReadFile(nodePath + "meminfo");
+
+        NumaNode node;
+        node.id = id;
+        node.cpus = ParseCpuList(ReadFile(nodePath + "cpulist"));
+        node.memTotal = NodeMeminfoBytes(meminfo, "MemTotal:");
+        node.memFree = NodeMeminfoBytes(meminfo, "MemFree:");
+        node.distances = ParseDistances(ReadFile(nodePath + "distance"));
+        node.hugePages = ReadHugePages(nodePath);
+        nodes.push_back(std::move(node));
+    }
+
+    return nodes;
+}
+
+} // namespace smbios
+
+#endif // __linux__
@@ -1,8 +1,13 @@
 #include "../smbios_common.h"
+#include "../smbios_cpuid.h"
+#include "../smbios_table.h"
 
 #ifdef __linux__
 
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <set>
 #include <string>
 
 namespace smbios {
@@ -10,6 +15,17 @@ namespace smbios {
 // DMI information is typically available in /sys/class/dmi/id/
 const std::string DMI_PATH = "/sys/class/dmi/id/";
 
+// Raw SMBIOS entry point and structure table exported by the kernel
+const std::string DMI_TABLES_PATH = "/sys/firmware/dmi/tables/";
+
+/**
+ * Trimmed value after the ':' of a "key : value" line, without the
+ * substr/trim temporaries
+ */
+std::string_view ValueAfter(const std::string& line, size_t colon) {
+    return TrimView(std::string_view(line).substr(colon + 1));
+}
+
 /**
  * Read DMI file content
  */
@@ -18,6 +34,70 @@ std::string ReadDMI(const std::string& filename) {
     return ReadFile(path);
 }
 
+RawTable ReadRawTable() {
+    RawTable table;
+    table.data = ReadBinaryFile(DMI_TABLES_PATH + "DMI");
+    if (table.data.empty()) {
+        return table;
+    }
+    
+    // Version lives in the entry point: "_SM3_" (64-bit) or "_SM_" (32-bit)
+    std::vector<uint8_t> entry = ReadBinaryFile(DMI_TABLES_PATH + "smbios_entry_point");
+    if (entry.size() >= 9 && std::memcmp(entry.data(), "_SM3_", 5) == 0) {
+        table.majorVersion = entry[7];
+        table.minorVersion = entry[8];
+    } else if (entry.size() >= 8 && std::memcmp(entry.data(), "_SM_", 4) == 0) {
+        table.majorVersion = entry[6];
+        table.minorVersion = entry[7];
+    }
+    
+    return table;
+}
+
+std::string GetBootId() {
+    return ReadFile("/proc/sys/kernel/random/boot_id");
+}
+
+void ReadPrivateFields(Snapshot& snapshot) {
+    // Mode 0400 in sysfs: empty for unprivileged processes
+    snapshot.system.serialNumber = ReadDMI("product_serial");
+    snapshot.system.uuid = ReadDMI("product_uuid");
+    snapshot.board.serialNumber = ReadDMI("board_serial");
+    snapshot.chassis.serialNumber = ReadDMI("chassis_serial");
+}
+
+std::string ReadCpuFlags() {
+    // "flags" on x86, "Features" on ARM; every CPU repeats the same line
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 5, "flags") == 0 || line.compare(0, 8, "Features") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                return std::string(ValueAfter(line, colon));
+            }
+        }
+    }
+    return "";
+}
+
+std::string ReadHypervisorHint() {
+    // Xen (and s390 z/VM) guests get /sys/hypervisor; ARM guests declare
+    // the hypervisor in the device tree ("xen,xen", "linux,kvm")
+    std::string type = ReadFile("/sys/hypervisor/type");
+    if (!type.empty()) {
+        return type;
+    }
+    std::string compatible = ReadFile("/proc/device-tree/hypervisor/compatible");
+    if (compatible.compare(0, 3, "xen") == 0) {
+        return "xen";
+    }
+    if (compatible.find("kvm") != std::string::npos) {
+        return "kvm";
+    }
+    return compatible.empty() ? "" : "unknown";
+}
+
 BiosInfo GetBiosInfo() {
     BiosInfo info;
     
@@ -40,18 +120,6 @@ SystemInfo GetSystemInfo() {
     info.family = ReadDMI("product_family");
     info.wakeUpType = ReadDMI("chassis_type");
     
-    // Clean up common placeholder values
-    if (info.serialNumber == "To Be Filled By O.E.M." || 
-        info.serialNumber == "System Serial Number" ||
-        info.serialNumber == "0") {
-        info.serialNumber = "";
-    }
-    
-    if (info.uuid == "To Be Filled By O.E.M." || 
-        info.uuid == "00000000-0000-0000-0000-000000000000") {
-        info.uuid = "";
-    }
-    
     return info;
 }
 
@@ -65,78 +133,169 @@ BoardInfo GetBoardInfo() {
     info.assetTag = ReadDMI("board_asset_tag");
     info.locationInChassis = ReadDMI("chassis_vendor");
     
-    // Clean up common placeholder values
-    if (info.serialNumber == "To Be Filled By O.E.M." || 
-        info.serialNumber == "Board Serial Number" ||
-        info.serialNumber == "0") {
-        info.serialNumber = "";
+    return info;
+}
+
+namespace {
+
+/**
+ * Identification fields from the first processor block of /proc/cpuinfo
+ */
+void ReadCpuinfoProcessor(ProcessorInfo& info) {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    if (!cpuinfo.is_open()) {
+        return;
     }
     
-    if (info.assetTag == "To Be Filled By O.E.M." || 
-        info.assetTag == "Asset Tag" ||
-        info.assetTag == "0") {
-        info.assetTag = "";
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        // Every block repeats the same values; stop after the first
+        if (line.empty() && !info.manufacturer.empty()) {
+            break;
+        }
+        size_t pos = line.find(":");
+        if (pos == std::string::npos) {
+            continue;
+        }
+        if (line.find("vendor_id") != std::string::npos) {
+            info.manufacturer = std::string(ValueAfter(line, pos));
+        } else if (line.find("model name") != std::string::npos) {
+            info.version = std::string(ValueAfter(line, pos));
+        } else if (line.find("cpu family") != std::string::npos) {
+            info.processorFamily = std::string(ValueAfter(line, pos));
+        } else if (line.find("cpu MHz") != std::string::npos) {
+            info.currentSpeed = std::string(ValueAfter(line, pos));
+        } else if (line.find("cpu cores") != std::string::npos) {
+            info.coreCount = std::string(ValueAfter(line, pos));
+        } else if (line.find("siblings") != std::string::npos && info.threadCount.empty()) {
+            info.threadCount = std::string(ValueAfter(line, pos));
+        }
+    }
+}
+
+/**
+ * Cache size in the sysfs "<n>K" format
+ */
+std::string FormatCacheSize(uint64_t bytes) {
+    return std::to_string(bytes / 1024) + "K";
+}
+
+/**
+ * Cores in CPU 0's package from the sysfs topology: every core lists its
+ * hardware threads once in core_cpus_list (thread_siblings_list before
+ * Linux 5.7). 0 if the topology is not exposed.
+ */
+uint32_t CountPackageCores() {
+    const std::string cpuPath = "/sys/devices/system/cpu/";
+    std::string package = ReadFile(cpuPath + "cpu0/topology/physical_package_id");
+    std::set<std::string> cores;
+    for (uint32_t cpu : ParseCpuList(ReadFile(cpuPath + "online"))) {
+        std::string topology = cpuPath + "cpu" + std::to_string(cpu) + "/topology/";
+        if (ReadFile(topology + "physical_package_id") != package) {
+            continue;
+        }
+        std::string threads = ReadFile(topology + "core_cpus_list");
+        if (threads.empty()) {
+            threads = ReadFile(topology + "thread_siblings_list");
+        }
+        if (threads.empty()) {
+            return 0;
+        }
+        cores.insert(threads);
+    }
+    return static_cast<uint32_t>(cores.size());
+}
+
+/**
+ * Identification straight from CPUID: no file parsing. Only the current
+ * speed needs the OS, from the held-open cpufreq files, or the nominal
+ * frequency when the host has no cpufreq driver. On hybrid parts the
+ * core count comes from the sysfs topology and the L2 size from CPU 0's
+ * cache directory (its core type), since CPUID only describes the core
+ * it ran on.
+ */
+void ReadCpuidProcessor(const CpuidProcessor& cpuid, ProcessorInfo& info) {
+    info.manufacturer = cpuid.vendor;
+    info.version = cpuid.brand;
+    info.processorFamily = std::to_string(cpuid.family);
+    uint32_t cores = cpuid.hybrid ? CountPackageCores() : cpuid.coresPerPackage;
+    ProcessorInfo cpuinfo;
+    if (cores != 0) {
+        info.coreCount = std::to_string(cores);
+    } else {
+        ReadCpuinfoProcessor(cpuinfo);
+        info.coreCount = cpuinfo.coreCount;
+    }
+    info.threadCount = std::to_string(cpuid.logicalPerPackage);
+    if (cpuid.l2Size != 0) {
+        info.l2CacheSize = FormatCacheSize(cpuid.l2Size);
+    }
+    if (cpuid.l3Size != 0) {
+        info.l3CacheSize = FormatCacheSize(cpuid.l3Size);
     }
     
-    return info;
+    std::vector<double> mhz;
+    SampleCpuFrequencies(mhz);
+    for (double value : mhz) {
+        if (std::isfinite(value)) {
+            info.currentSpeed = FormatMhz(value);
+            break;
+        }
+    }
+    if (info.currentSpeed.empty() && cpuid.baseMhz != 0) {
+        info.currentSpeed = FormatMhz(cpuid.baseMhz);
+    }
+    if (info.currentSpeed.empty()) {
+        if (cpuinfo.manufacturer.empty()) {
+            ReadCpuinfoProcessor(cpuinfo);
+        }
+        info.currentSpeed = cpuinfo.currentSpeed;
+    }
 }
 
+} // namespace
+
 ProcessorInfo GetProcessorInfo() {
     ProcessorInfo info;
     
-    // Try to read from /proc/cpuinfo
-    std::ifstream cpuinfo("/proc/cpuinfo");
-    if (cpuinfo.is_open()) {
-        std::string line;
-        while (std::getline(cpuinfo, line)) {
-            if (line.find("vendor_id") != std::string::npos) {
-                size_t pos = line.find(":");
-                if (pos != std::string::npos) {
-                    info.manufacturer = TrimString(line.substr(pos + 1));
-                }
-            } else if (line.find("model name") != std::string::npos) {
-                size_t pos = line.find(":");
-                if (pos != std::string::npos) {
-                    info.version = TrimString(line.substr(pos + 1));
-                }
-            } else if (line.find("cpu family") != std::string::npos) {
-                size_t pos = line.find(":");
-                if (pos != std::string::npos) {
-                    info.processorFamily = TrimString(line.substr(pos + 1));
-                }
-            } else if (line.find("cpu MHz") != std::string::npos) {
-                size_t pos = line.find(":");
-                if (pos != std::string::npos) {
-                    info.currentSpeed = TrimString(line.substr(pos + 1));
-                }
-            } else if (line.find("cpu cores") != std::string::npos) {
-                size_t pos = line.find(":");
-                if (pos != std::string::npos) {
-                    info.coreCount = TrimString(line.substr(pos + 1));
-                }
-            } else if (line.find("siblings") != std::string::npos && info.threadCount.empty()) {
-                size_t pos = line.find(":");
-                if (pos != std::string::npos) {
-                    info.threadCount = TrimString(line.substr(pos + 1));
-                }
-            }
-        }
-        cpuinfo.close();
+    const CpuidProcessor* cpuid = GetCpuidProcessor();
+    if (cpuid) {
+        ReadCpuidProcessor(*cpuid, info);
+    } else {
+        ReadCpuinfoProcessor(info);
     }
     
-    info.socketDesignation = "CPU Socket";
-    info.processorType = "Central Processor";
-    info.maxSpeed = info.currentSpeed; // Approximation
+    // Socket, type and rated speed come from SMBIOS type 4 when the table
+    // is readable; /proc/cpuinfo has no equivalent
+    std::vector<ProcessorSocket> sockets = GetProcessorSockets();
+    if (!sockets.empty()) {
+        const ProcessorSocket& socket = sockets.front();
+        info.socketDesignation = socket.socketDesignation;
+        info.processorType = socket.processorType;
+        if (socket.maxSpeed != 0) {
+            info.maxSpeed = FormatMhz(socket.maxSpeed);
+        }
+    }
     
-    // Try to get cache sizes
-    std::string l2Cache = ReadFile("/sys/devices/system/cpu/cpu0/cache/index2/size");
-    if (!l2Cache.empty()) {
-        info.l2CacheSize = l2Cache;
+    if (info.socketDesignation.empty()) {
+        info.socketDesignation = "CPU Socket";
+    }
+    if (info.processorType.empty()) {
+        info.processorType = "Central Processor";
+    }
+    if (info.maxSpeed.empty() && cpuid && cpuid->maxMhz != 0) {
+        info.maxSpeed = FormatMhz(cpuid->maxMhz);
+    }
+    if (info.maxSpeed.empty()) {
+        info.maxSpeed = info.currentSpeed; // Approximation
     }
     
-    std::string l3Cache = ReadFile("/sys/devices/system/cpu/cpu0/cache/index3/size");
-    if (!l3Cache.empty()) {
-        info.l3CacheSize = l3Cache;
+    // Cache sizes, where CPUID did not provide them
+    if (info.l2CacheSize.empty()) {
+        info.l2CacheSize = ReadFile("/sys/devices/system/cpu/cpu0/cache/index2/size");
+    }
+    if (info.l3CacheSize.empty()) {
+        info.l3CacheSize = ReadFile("/sys/devices/system/cpu/cpu0/cache/index3/size");
     }
     
     return info;
@@ -153,7 +312,7 @@ MemoryInfo GetMemoryInfo() {
             if (line.find("MemTotal") != std::string::npos) {
                 size_t pos = line.find(":");
                 if (pos != std::string::npos) {
-                    std::string value = TrimString(line.substr(pos + 1));
+                    std::string value = std::string(ValueAfter(line, pos));
                     // Convert from KB to bytes
                     try {
                         size_t kb = std::stoull(value);
@@ -165,7 +324,7 @@ MemoryInfo GetMemoryInfo() {
             } else if (line.find("MemAvailable") != std::string::npos) {
                 size_t pos = line.find(":");
                 if (pos != std::string::npos) {
-                    std::string value = TrimString(line.substr(pos + 1));
+                    std::string value = std::string(ValueAfter(line, pos));
                     try {
                         size_t kb = std::stoull(value);
                         info.availablePhysicalMemory = std::to_string(kb * 1024);
@@ -176,12 +335,12 @@ MemoryInfo GetMemoryInfo() {
             } else if (line.find("SwapTotal") != std::string::npos) {
                 size_t pos = line.find(":");
                 if (pos != std::string::npos) {
-                    info.totalVirtualMemory = TrimString(line.substr(pos + 1));
+                    info.totalVirtualMemory = std::string(ValueAfter(line, pos));
                 }
             } else if (line.find("SwapFree") != std::string::npos) {
                 size_t pos = line.find(":");
                 if (pos != std::string::npos) {
-                    info.availableVirtualMemory = TrimString(line.substr(pos + 1));
+                    info.availableVirtualMemory = std::string(ValueAfter(line, pos));
                 }
             }
         }
@@ -202,9 +361,20 @@ ChassisInfo GetChassisInfo() {
     info.version = ReadDMI("chassis_version");
     info.serialNumber = ReadDMI("chassis_serial");
     info.assetTag = ReadDMI("chassis_asset_tag");
-    info.bootUpState = "Normal";
-    info.powerSupplyState = "Safe";
-    info.thermalState = "Safe";
+    
+    // Firmware states as recorded at boot when the table is readable (root
+    // only), else the previous defaults; the thermal state comes from the
+    // sensors when there are any
+    ChassisStates states = GetChassisStates();
+    info.bootUpState = states.bootUp.empty() ? "Normal" : states.bootUp;
+    info.powerSupplyState = states.powerSupply.empty() ? "Safe" : states.powerSupply;
+    std::vector<double> celsius;
+    ThermalState thermal = SampleTemperatures(celsius);
+    if (thermal != THERMAL_STATE_UNKNOWN) {
+        info.thermalState = ThermalStateName(thermal);
+    } else {
+        info.thermalState = states.thermal.empty() ? "Safe" : states.thermal;
+    }
     
     return info;
 }
@@ -0,0 +1,158 @@
+#include "../smbios_common.h"
+#include "sysfs_file.h"
+
+#ifdef __linux__
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+/**
+ * /proc/meminfo held open and parsed in place
+ */
+class MemoryStatsSampler {
+public:
+    MemoryStatsSampler() : file("/proc/meminfo") {}
+
+    void Sample(double (&stats)[MEMORY_STAT_COUNT]) {
+        static const struct {
+            const char* key;
+            MemoryStat stat;
+        } keys[] = {
+            { "MemTotal:", MEMORY_STAT_TOTAL },
+            { "MemFree:", MEMORY_STAT_FREE },
+            { "MemAvailable:", MEMORY_STAT_AVAILABLE },
+            { "Buffers:", MEMORY_STAT_BUFFERS },
+            { "Cached:", MEMORY_STAT_CACHED },
+            { "SwapTotal:", MEMORY_STAT_SWAP_TOTAL },
+            { "SwapFree:", MEMORY_STAT_SWAP_FREE },
+        };
+
+        for (double& value : stats) {
+            value = NAN;
+        }
+        if (file.Read(buffer, sizeof(buffer)) <= 0) {
+            return;
+        }
+
+        for (const char* line = buffer; *line; ) {
+            for (const auto& key : keys) {
+                size_t length = std::strlen(key.key);
+                if (std::strncmp(line, key.key, length) == 0) {
+                    stats[key.stat] = std::strtod(line + length, nullptr) * 1024;
+                    break;
+                }
+            }
+            const char* next = std::strchr(line, '\n');
+            if (!next) {
+                break;
+            }
+            line = next + 1;
+        }
+    }
+
+private:
+    SysfsFile file;
+    char buffer[8192];
+};
+
+/**
+ * /proc/stat held open and parsed in place; the caller's CpuLoadState
+ * turns the jiffy counters into a load since its previous sample
+ */
+class CpuLoadSampler {
+public:
+    CpuLoadSampler() : file("/proc/stat"), buffer(64 * 1024) {}
+
+    double Sample(CpuLoadState& state, std::vector<double>& load) {
+        // The per-CPU lines come first, so a truncated read of a huge
+        // "intr" line further down does not matter
+        if (file.Read(buffer.data(), buffer.size()) <= 0) {
+            load.clear();
+            return NAN;
+        }
+
+        size_t count = 0;
+        double overall = NAN;
+        for (const char* line = buffer.data(); std::strncmp(line, "cpu", 3) == 0; ) {
+            const char* p = line + 3;
+            bool aggregate = *p == ' ';
+            size_t cpu = 0;
+            if (!aggregate) {
+                char* end = nullptr;
+                cpu = std::strtoul(p, &end, 10);
+                p = end;
+            }
+
+            // user nice system idle iowait irq softirq steal; guest time
+            // is already included in user/nice
+            uint64_t total = 0;
+            uint64_t idle = 0;
+            for (int field = 0; field < 8; field++) {
+                char* end = nullptr;
+                uint64_t value = std::strtoull(p, &end, 10);
+                if (end == p) {
+                    break;
+                }
+                total += value;
+                if (field == 3 || field == 4) {
+                    idle += value;
+                }
+                p = end;
+            }
+
+            if (aggregate) {
+                overall = UpdateCpuLoad(state.system, total, idle);
+            } else {
+                if (cpu >= state.cpus.size()) {
+                    state.cpus.resize(cpu + 1);
+                }
+                if (cpu >= load.size()) {
+                    load.resize(cpu + 1, NAN);
+                }
+                load[cpu] = UpdateCpuLoad(state.cpus[cpu], total, idle);
+                count = cpu + 1;
+            }
+
+            const char* next = std::strchr(line, '\n');
+            if (!next) {
+                break;
+            }
+            line = next + 1;
+        }
+
+        load.resize(count);
+        return overall;
+    }
+
+private:
+    SysfsFile file;
+    std::vector<char> buffer;
+};
+
+std::mutex memoryMutex;
+std::mutex loadMutex;
+
+} // namespace
+
+void SampleMemoryStats(double (&stats)[MEMORY_STAT_COUNT]) {
+    static MemoryStatsSampler sampler;
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    sampler.Sample(stats);
+}
+
+double SampleCpuLoads(CpuLoadState& state, std::vector<double>& load) {
+    static CpuLoadSampler sampler;
+    std::lock_guard<std::mutex> lock(loadMutex);
+    return sampler.Sample(state, load);
+}
+
+} // namespace smbios
+
+#endif // __linux__
@@ -0,0 +1,68 @@
+#include "sysfs_file.h"
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace smbios {
+
+SysfsFile::SysfsFile(const std::string& path) {
+    fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+SysfsFile::~SysfsFile() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+SysfsFile& SysfsFile::operator=(SysfsFile&& other) noexcept {
+    if (this != &other) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        fd = other.fd;
+        other.fd = -1;
+    }
+    return *this;
+}
+
+long SysfsFile::Read(char* buffer, size_t size) const {
+    if (fd < 0 || size == 0) {
+        return -1;
+    }
+
+    ssize_t n;
+    do {
+        n = pread(fd, buffer, size - 1, 0);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        buffer[0] = '\0';
+        return -1;
+    }
+    buffer[n] = '\0';
+    return static_cast<long>(n);
+}
+
+bool SysfsFile::ReadInt64(int64_t& value) const {
+    char buffer[32];
+    if (Read(buffer, sizeof(buffer)) <= 0) {
+        return false;
+    }
+
+    char* end = nullptr;
+    long long parsed = strtoll(buffer, &end, 10);
+    if (end == buffer) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+} // namespace smbios
+
+#endif // __linux__
@@ -0,0 +1,51 @@
+#ifndef SMBIOS_SYSFS_FILE_H
+#define SMBIOS_SYSFS_FILE_H
+
+#ifdef __linux__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace smbios {
+
+/**
+ * sysfs/procfs attribute kept open between reads.
+ *
+ * These files regenerate their contents on every read from offset 0, so
+ * a sampler can hold the descriptor and pread() it instead of paying for
+ * open/close each time.
+ */
+class SysfsFile {
+public:
+    SysfsFile() : fd(-1) {}
+    explicit SysfsFile(const std::string& path);
+    ~SysfsFile();
+
+    SysfsFile(SysfsFile&& other) noexcept : fd(other.fd) { other.fd = -1; }
+    SysfsFile& operator=(SysfsFile&& other) noexcept;
+    SysfsFile(const SysfsFile&) = delete;
+    SysfsFile& operator=(const SysfsFile&) = delete;
+
+    bool IsOpen() const { return fd >= 0; }
+
+    /**
+     * Read the current contents into buffer (NUL-terminated).
+     * Returns the number of bytes read, or -1 on error.
+     */
+    long Read(char* buffer, size_t size) const;
+
+    /**
+     * Read the leading integer of the file
+     */
+    bool ReadInt64(int64_t& value) const;
+
+private:
+    int fd;
+};
+
+} // namespace smbios
+
+#endif // __linux__
+
+#endif // SMBIOS_SYSFS_FILE_H
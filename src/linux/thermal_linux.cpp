@@ -0,0 +1,236 @@
+#include "../smbios_common.h"
+#include "sysfs_file.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+const std::string HWMON_PATH = "/sys/class/hwmon/";
+const std::string THERMAL_PATH = "/sys/class/thermal/";
+
+/**
+ * Thermal zone types that measure a whole CPU package
+ */
+const char* const PACKAGE_ZONES[] = { "x86_pkg_temp", "cpu-thermal", "cpu_thermal" };
+
+/**
+ * Entries of dir named <prefix><number><suffix>, ordered by number
+ */
+std::vector<std::pair<long, std::string>> ListNumbered(const std::string& dir, const char* prefix,
+                                                       const char* suffix) {
+    std::vector<std::pair<long, std::string>> entries;
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) {
+        return entries;
+    }
+
+    size_t prefixLength = std::strlen(prefix);
+    while (struct dirent* entry = readdir(handle)) {
+        const char* name = entry->d_name;
+        if (std::strncmp(name, prefix, prefixLength) != 0) {
+            continue;
+        }
+        char* end = nullptr;
+        long number = std::strtol(name + prefixLength, &end, 10);
+        if (end != name + prefixLength && std::strcmp(end, suffix) == 0) {
+            entries.emplace_back(number, name);
+        }
+    }
+    closedir(handle);
+
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+/**
+ * Millidegree attribute in °C, 0 if missing or not positive (firmware
+ * often leaves unused trip points at 0 or negative)
+ */
+double ReadTripPoint(const std::string& path) {
+    std::string text = ReadFile(path);
+    char* end = nullptr;
+    long long value = std::strtoll(text.c_str(), &end, 10);
+    return end != text.c_str() && value > 0 ? value / 1000.0 : 0;
+}
+
+/**
+ * Number following `prefix` at the start of label, or -1
+ */
+int32_t LabelNumber(const std::string& label, const char* prefix) {
+    size_t length = std::strlen(prefix);
+    if (label.compare(0, length, prefix) != 0) {
+        return -1;
+    }
+    char* end = nullptr;
+    long number = std::strtol(label.c_str() + length, &end, 10);
+    return end != label.c_str() + length ? static_cast<int32_t>(number) : -1;
+}
+
+/**
+ * Every hwmon temperature channel and thermal zone, each with its input
+ * file held open. The sensor list is fixed after construction and reads
+ * only pread() the held descriptors, so sampling needs no lock.
+ */
+class ThermalSampler {
+public:
+    ThermalSampler() {
+        for (const auto& entry : ListNumbered(HWMON_PATH, "hwmon", "")) {
+            AddHwmon(HWMON_PATH + entry.second + "/");
+        }
+        for (const auto& entry : ListNumbered(THERMAL_PATH, "thermal_zone", "")) {
+            AddThermalZone(THERMAL_PATH + entry.second + "/");
+        }
+    }
+
+    const std::vector<ThermalSensor>& Sensors() const { return sensors; }
+
+    ThermalState Sample(std::vector<double>& celsius) const {
+        celsius.resize(sensors.size());
+        ThermalState state = THERMAL_STATE_UNKNOWN;
+        for (size_t i = 0; i < sensors.size(); i++) {
+            int64_t millidegrees = 0;
+            if (!inputs[i].ReadInt64(millidegrees)) {
+                celsius[i] = NAN;
+                continue;
+            }
+
+            double value = millidegrees / 1000.0;
+            celsius[i] = value;
+            const ThermalSensor& sensor = sensors[i];
+            ThermalState sensorState = THERMAL_STATE_SAFE;
+            if (sensor.critical > 0 && value >= sensor.critical) {
+                sensorState = THERMAL_STATE_CRITICAL;
+            } else if (sensor.warning > 0 && value >= sensor.warning) {
+                sensorState = THERMAL_STATE_WARNING;
+            }
+            state = std::max(state, sensorState);
+        }
+        return state;
+    }
+
+private:
+    /**
+     * temp<N>_input channels of one chip. coretemp registers one chip per
+     * package, labelled "Package id P" and "Core C"; k10temp reports the
+     * package as Tctl/Tdie.
+     */
+    void AddHwmon(const std::string& dir) {
+        std::string chip = ReadFile(dir + "name");
+        size_t first = sensors.size();
+        int32_t package = -1;
+
+        for (const auto& entry : ListNumbered(dir, "temp", "_input")) {
+            std::string base = dir + "temp" + std::to_string(entry.first) + "_";
+            SysfsFile input(dir + entry.second);
+            if (!input.IsOpen()) {
+                continue;
+            }
+
+            ThermalSensor sensor;
+            sensor.source = "hwmon";
+            sensor.name = chip;
+            sensor.label = ReadFile(base + "label");
+            if (sensor.label.empty()) {
+                sensor.label = chip + " temp" + std::to_string(entry.first);
+            }
+            sensor.warning = ReadTripPoint(base + "max");
+            sensor.critical = ReadTripPoint(base + "crit");
+            if (sensor.critical == 0) {
+                sensor.critical = ReadTripPoint(base + "emergency");
+            }
+
+            sensor.kind = "other";
+            if ((sensor.package = LabelNumber(sensor.label, "Package id ")) >= 0) {
+                sensor.kind = "package";
+                package = sensor.package;
+            } else if ((sensor.core = LabelNumber(sensor.label, "Core ")) >= 0) {
+                sensor.kind = "core";
+            } else if (sensor.label == "Tctl" || sensor.label == "Tdie") {
+                sensor.kind = "package";
+            }
+
+            sensors.push_back(std::move(sensor));
+            inputs.push_back(std::move(input));
+        }
+
+        // Core channels belong to the chip's package
+        for (size_t i = first; i < sensors.size(); i++) {
+            if (sensors[i].kind == "core") {
+                sensors[i].package = package;
+            }
+        }
+    }
+
+    /**
+     * A thermal zone with its passive/hot trip as the warning level and its
+     * critical trip; active trips only stage fans and are skipped
+     */
+    void AddThermalZone(const std::string& dir) {
+        SysfsFile input(dir + "temp");
+        if (!input.IsOpen()) {
+            return;
+        }
+
+        ThermalSensor sensor;
+        sensor.source = "thermal";
+        sensor.name = ReadFile(dir + "type");
+        sensor.label = sensor.name;
+        sensor.kind = "other";
+        for (const char* type : PACKAGE_ZONES) {
+            if (sensor.name == type) {
+                sensor.kind = "package";
+            }
+        }
+
+        for (const auto& entry : ListNumbered(dir, "trip_point_", "_type")) {
+            std::string base = dir + "trip_point_" + std::to_string(entry.first) + "_";
+            std::string type = ReadFile(dir + entry.second);
+            double temp = ReadTripPoint(base + "temp");
+            if (temp == 0) {
+                continue;
+            }
+            double* level = type == "critical" ? &sensor.critical
+                          : (type == "passive" || type == "hot") ? &sensor.warning
+                          : nullptr;
+            if (level && (*level == 0 || temp < *level)) {
+                *level = temp;
+            }
+        }
+
+        sensors.push_back(std::move(sensor));
+        inputs.push_back(std::move(input));
+    }
+
+    std::vector<ThermalSensor> sensors;
+    std::vector<SysfsFile> inputs;
+};
+
+const ThermalSampler& GetSampler() {
+    static const ThermalSampler sampler;
+    return sampler;
+}
+
+} // namespace
+
+std::vector<ThermalSensor> GetThermalSensors() {
+    return GetSampler().Sensors();
+}
+
+ThermalState SampleTemperatures(std::vector<double>& celsius) {
+    return GetSampler().Sample(celsius);
+}
+
+} // namespace smbios
+
+#endif // __linux__
@@ -1,9 +1,15 @@
 #include "../smbios_common.h"
+#include "../smbios_table.h"
 
 #ifdef __APPLE__
 
 #include <IOKit/IOKitLib.h>
 #include <CoreFoundation/CoreFoundation.h>
+#include <mach/mach.h>
+#include <sys/sysctl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <string>
 
 namespace smbios {
@@ -103,6 +109,79 @@ std::string GetIORegistryUUID(const char* service, const char* property) {
     return TrimString(result);
 }
 
+/**
+ * Helper function to get a data property as raw bytes
+ */
+std::vector<uint8_t> GetIORegistryData(const char* service, const char* property) {
+    std::vector<uint8_t> result;
+    
+    io_service_t smbiosService = IOServiceGetMatchingService(
+        kIOMasterPortDefault,
+        IOServiceMatching(service)
+    );
+    
+    if (smbiosService) {
+        CFStringRef key = CFStringCreateWithCString(kCFAllocatorDefault, property, kCFStringEncodingUTF8);
+        CFTypeRef cfProperty = IORegistryEntryCreateCFProperty(
+            smbiosService,
+            key,
+            kCFAllocatorDefault,
+            0
+        );
+        CFRelease(key);
+        
+        if (cfProperty) {
+            if (CFGetTypeID(cfProperty) == CFDataGetTypeID()) {
+                CFDataRef cfData = (CFDataRef)cfProperty;
+                const UInt8* bytes = CFDataGetBytePtr(cfData);
+                result.assign(bytes, bytes + CFDataGetLength(cfData));
+            }
+            
+            CFRelease(cfProperty);
+        }
+        
+        IOObjectRelease(smbiosService);
+    }
+    
+    return result;
+}
+
+RawTable ReadRawTable() {
+    RawTable table;
+    table.data = GetIORegistryData("AppleSMBIOS", "SMBIOS");
+    if (table.data.empty()) {
+        return table;
+    }
+    
+    std::vector<uint8_t> entry = GetIORegistryData("AppleSMBIOS", "SMBIOS-EPS");
+    if (entry.size() >= 9 && std::memcmp(entry.data(), "_SM3_", 5) == 0) {
+        table.majorVersion = entry[7];
+        table.minorVersion = entry[8];
+    } else if (entry.size() >= 8 && std::memcmp(entry.data(), "_SM_", 4) == 0) {
+        table.majorVersion = entry[6];
+        table.minorVersion = entry[7];
+    }
+    
+    return table;
+}
+
+std::string GetBootId() {
+    char buffer[64] = {};
+    size_t size = sizeof(buffer);
+    if (sysctlbyname("kern.bootsessionuuid", buffer, &size, nullptr, 0) != 0) {
+        return "";
+    }
+    return TrimString(buffer);
+}
+
+void ReadPrivateFields(Snapshot& snapshot) {
+    std::string serial = GetIORegistryString("IOPlatformExpertDevice", "IOPlatformSerialNumber");
+    snapshot.system.serialNumber = serial;
+    snapshot.system.uuid = GetIORegistryUUID("IOPlatformExpertDevice", "IOPlatformUUID");
+    snapshot.board.serialNumber = serial;
+    snapshot.chassis.serialNumber = serial;
+}
+
 BiosInfo GetBiosInfo() {
     BiosInfo info;
     
@@ -212,13 +291,179 @@ ChassisInfo GetChassisInfo() {
     info.version = GetIORegistryString("IOPlatformExpertDevice", "version");
     info.serialNumber = GetIORegistryString("IOPlatformExpertDevice", "IOPlatformSerialNumber");
     info.assetTag = GetIORegistryString("IOPlatformExpertDevice", "model");
-    info.bootUpState = "Normal";
-    info.powerSupplyState = "Safe";
-    info.thermalState = "Safe";
+    
+    // Firmware states when the table is readable, else the previous defaults
+    ChassisStates states = GetChassisStates();
+    info.bootUpState = states.bootUp.empty() ? "Normal" : states.bootUp;
+    info.powerSupplyState = states.powerSupply.empty() ? "Safe" : states.powerSupply;
+    info.thermalState = states.thermal.empty() ? "Safe" : states.thermal;
     
     return info;
 }
 
+void SampleCpuFrequencies(std::vector<double>& mhz) {
+    // macOS does not expose per-core frequencies to unprivileged processes
+    mhz.clear();
+}
+
+void SampleMemoryStats(double (&stats)[MEMORY_STAT_COUNT]) {
+    for (double& value : stats) {
+        value = NAN;
+    }
+    
+    uint64_t memsize = 0;
+    size_t size = sizeof(memsize);
+    if (sysctlbyname("hw.memsize", &memsize, &size, nullptr, 0) == 0) {
+        stats[MEMORY_STAT_TOTAL] = static_cast<double>(memsize);
+    }
+    
+    vm_statistics64_data_t vm;
+    mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+    vm_size_t pageSize = 0;
+    if (host_page_size(mach_host_self(), &pageSize) == KERN_SUCCESS &&
+        host_statistics64(mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&vm), &count) == KERN_SUCCESS) {
+        stats[MEMORY_STAT_FREE] = static_cast<double>(vm.free_count) * pageSize;
+        stats[MEMORY_STAT_AVAILABLE] = static_cast<double>(vm.free_count + vm.inactive_count + vm.purgeable_count) * pageSize;
+        stats[MEMORY_STAT_CACHED] = static_cast<double>(vm.external_page_count) * pageSize;
+    }
+    
+    xsw_usage swap = {};
+    size = sizeof(swap);
+    if (sysctlbyname("vm.swapusage", &swap, &size, nullptr, 0) == 0) {
+        stats[MEMORY_STAT_SWAP_TOTAL] = static_cast<double>(swap.xsu_total);
+        stats[MEMORY_STAT_SWAP_FREE] = static_cast<double>(swap.xsu_avail);
+    }
+}
+
+double SampleCpuLoads(CpuLoadState& state, std::vector<double>& load) {
+    natural_t count = 0;
+    processor_info_array_t info = nullptr;
+    mach_msg_type_number_t infoCount = 0;
+    if (host_processor_info(mach_host_self(), PROCESSOR_CPU_LOAD_INFO, &count, &info, &infoCount) != KERN_SUCCESS) {
+        load.clear();
+        return NAN;
+    }
+    
+    state.cpus.resize(std::max<size_t>(state.cpus.size(), count));
+    load.resize(count);
+    uint64_t systemTotal = 0;
+    uint64_t systemIdle = 0;
+    for (natural_t i = 0; i < count; i++) {
+        const integer_t* ticks = info + i * CPU_STATE_MAX;
+        uint64_t idle = static_cast<uint32_t>(ticks[CPU_STATE_IDLE]);
+        uint64_t total = idle + static_cast<uint32_t>(ticks[CPU_STATE_USER]) +
+                         static_cast<uint32_t>(ticks[CPU_STATE_SYSTEM]) + static_cast<uint32_t>(ticks[CPU_STATE_NICE]);
+        load[i] = UpdateCpuLoad(state.cpus[i], total, idle);
+        systemTotal += total;
+        systemIdle += idle;
+    }
+    vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(info), infoCount * sizeof(integer_t));
+    
+    return UpdateCpuLoad(state.system, systemTotal, systemIdle);
+}
+
+std::string ReadCpuFlags() {
+    // x86 uses CPUID directly; on Apple silicon map the hw.optional.arm
+    // feature sysctls to their HWCAP names
+    static const struct {
+        const char* sysctl;
+        const char* flags;
+    } features[] = {
+        { "hw.optional.floatingpoint", "fp asimd" },
+        { "hw.optional.arm.FEAT_AES", "aes" },
+        { "hw.optional.arm.FEAT_PMULL", "pmull" },
+        { "hw.optional.arm.FEAT_SHA1", "sha1" },
+        { "hw.optional.arm.FEAT_SHA256", "sha2" },
+        { "hw.optional.arm.FEAT_SHA512", "sha512" },
+        { "hw.optional.arm.FEAT_SHA3", "sha3" },
+        { "hw.optional.armv8_crc32", "crc32" },
+        { "hw.optional.arm.FEAT_LSE", "atomics" },
+        { "hw.optional.arm.FEAT_FP16", "fphp asimdhp" },
+        { "hw.optional.arm.FEAT_RDM", "asimdrdm" },
+        { "hw.optional.arm.FEAT_JSCVT", "jscvt" },
+        { "hw.optional.arm.FEAT_FCMA", "fcma" },
+        { "hw.optional.arm.FEAT_LRCPC", "lrcpc" },
+        { "hw.optional.arm.FEAT_LRCPC2", "ilrcpc" },
+        { "hw.optional.arm.FEAT_DotProd", "asimddp" },
+        { "hw.optional.arm.FEAT_FHM", "asimdfhm" },
+        { "hw.optional.arm.FEAT_DIT", "dit" },
+        { "hw.optional.arm.FEAT_FlagM", "flagm" },
+        { "hw.optional.arm.FEAT_SSBS", "ssbs" },
+        { "hw.optional.arm.FEAT_SB", "sb" },
+        { "hw.optional.arm.FEAT_BF16", "bf16" },
+        { "hw.optional.arm.FEAT_I8MM", "i8mm" },
+    };
+    
+    std::string flags;
+    for (const auto& feature : features) {
+        int value = 0;
+        size_t size = sizeof(value);
+        if (sysctlbyname(feature.sysctl, &value, &size, nullptr, 0) == 0 && value != 0) {
+            if (!flags.empty()) {
+                flags += ' ';
+            }
+            flags += feature.flags;
+        }
+    }
+    return flags;
+}
+
+std::vector<NumaNode> GetNumaNodes() {
+    // macOS does not expose a NUMA layout
+    return {};
+}
+
+std::vector<CacheInstance> GetCacheTopology() {
+    // hw.l*cachesize give sizes but not which CPUs share each cache
+    return {};
+}
+
+EffectiveLimits GetEffectiveLimits() {
+    // No affinity or resource limits to apply: the host is the limit
+    EffectiveLimits limits;
+    
+    int cpus = 0;
+    size_t size = sizeof(cpus);
+    if (sysctlbyname("hw.logicalcpu", &cpus, &size, nullptr, 0) == 0 && cpus > 0) {
+        limits.hostCpus = static_cast<uint32_t>(cpus);
+        for (uint32_t cpu = 0; cpu < limits.hostCpus; cpu++) {
+            limits.cpus.push_back(cpu);
+        }
+    }
+    
+    uint64_t memsize = 0;
+    size = sizeof(memsize);
+    if (sysctlbyname("hw.memsize", &memsize, &size, nullptr, 0) == 0) {
+        limits.hostMemory = memsize;
+    }
+    
+    limits.effectiveCpus = limits.hostCpus;
+    limits.effectiveMemory = limits.hostMemory;
+    return limits;
+}
+
+std::vector<ThermalSensor> GetThermalSensors() {
+    // Die temperatures are only readable through private SMC/IOHID
+    // interfaces
+    return {};
+}
+
+ThermalState SampleTemperatures(std::vector<double>& celsius) {
+    celsius.clear();
+    return THERMAL_STATE_UNKNOWN;
+}
+
+std::string ReadHypervisorHint() {
+    // Set by the kernel when running under any hypervisor (including
+    // Virtualization.framework guests on Apple silicon, which lack CPUID)
+    int present = 0;
+    size_t size = sizeof(present);
+    if (sysctlbyname("kern.hv_vmm_present", &present, &size, nullptr, 0) == 0 && present) {
+        return "unknown";
+    }
+    return "";
+}
+
 } // namespace smbios
 
 #endif // __APPLE__
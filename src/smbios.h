@@ -0,0 +1,615 @@
+#ifndef SMBIOS_H
+#define SMBIOS_H
+
+/**
+ * Public C++ API of the smbios-core static library, for native programs
+ * that embed the collection logic without Node.js.
+ *
+ * Everything declared here may be called concurrently from any number of
+ * threads:
+ *  - GetSnapshot() and the static categories go through the process-wide
+ *    cache (or the shared snapshot), so only the first call collects;
+ *  - the samplers (frequencies, loads, memory stats, OpenMetrics) keep
+ *    their held-open files behind a lock;
+ *  - the remaining Get*() functions only read platform files/APIs.
+ *
+ * The plain Get*Info() functions always query the platform and skip the
+ * cache and placeholder cleanup, so unprogrammed values such as a "0"
+ * serial number come back as reported; prefer GetSnapshot().
+ *
+ * smbios_fields.h adds the field descriptor tables for walking the info
+ * structs generically. Everything else under src/ is internal.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace smbios {
+
+// The info structs are templates over their string type: the plain
+// aliases (BiosInfo, ...) own std::string values, the *View aliases hold
+// std::string_view into a PackedSnapshot arena or a mapped shared snapshot.
+
+/**
+ * BIOS Information structure
+ */
+template <typename Str>
+struct BasicBiosInfo {
+    using string_type = Str;
+    Str vendor;
+    Str version;
+    Str releaseDate;
+    Str biosCharacteristics;
+};
+using BiosInfo = BasicBiosInfo<std::string>;
+using BiosInfoView = BasicBiosInfo<std::string_view>;
+
+/**
+ * System Information structure
+ */
+template <typename Str>
+struct BasicSystemInfo {
+    using string_type = Str;
+    Str manufacturer;
+    Str productName;
+    Str serialNumber;
+    Str uuid;
+    Str skuNumber;
+    Str family;
+    Str wakeUpType;
+};
+using SystemInfo = BasicSystemInfo<std::string>;
+using SystemInfoView = BasicSystemInfo<std::string_view>;
+
+/**
+ * Board/Baseboard Information structure
+ */
+template <typename Str>
+struct BasicBoardInfo {
+    using string_type = Str;
+    Str manufacturer;
+    Str product;
+    Str version;
+    Str serialNumber;
+    Str assetTag;
+    Str locationInChassis;
+};
+using BoardInfo = BasicBoardInfo<std::string>;
+using BoardInfoView = BasicBoardInfo<std::string_view>;
+
+/**
+ * Processor Information structure
+ */
+template <typename Str>
+struct BasicProcessorInfo {
+    using string_type = Str;
+    Str manufacturer;
+    Str version;
+    Str socketDesignation;
+    Str processorType;
+    Str processorFamily;
+    Str maxSpeed;
+    Str currentSpeed;
+    Str coreCount;
+    Str threadCount;
+    Str l2CacheSize;
+    Str l3CacheSize;
+};
+using ProcessorInfo = BasicProcessorInfo<std::string>;
+using ProcessorInfoView = BasicProcessorInfo<std::string_view>;
+
+/**
+ * Memory Information structure
+ */
+template <typename Str>
+struct BasicMemoryInfo {
+    using string_type = Str;
+    Str totalPhysicalMemory;
+    Str availablePhysicalMemory;
+    Str totalVirtualMemory;
+    Str availableVirtualMemory;
+    Str memoryDevices;
+    Str maxCapacity;
+};
+using MemoryInfo = BasicMemoryInfo<std::string>;
+using MemoryInfoView = BasicMemoryInfo<std::string_view>;
+
+/**
+ * Chassis Information structure
+ */
+template <typename Str>
+struct BasicChassisInfo {
+    using string_type = Str;
+    Str manufacturer;
+    Str type;
+    Str version;
+    Str serialNumber;
+    Str assetTag;
+    Str bootUpState;
+    Str powerSupplyState;
+    Str thermalState;
+};
+using ChassisInfo = BasicChassisInfo<std::string>;
+using ChassisInfoView = BasicChassisInfo<std::string_view>;
+
+/**
+ * All categories at once, as returned by getAllInfo()
+ */
+template <typename Str>
+struct BasicSnapshot {
+    BasicBiosInfo<Str> bios;
+    BasicSystemInfo<Str> system;
+    BasicBoardInfo<Str> board;
+    BasicProcessorInfo<Str> processor;
+    BasicMemoryInfo<Str> memory;
+    BasicChassisInfo<Str> chassis;
+};
+using Snapshot = BasicSnapshot<std::string>;
+using SnapshotView = BasicSnapshot<std::string_view>;
+
+/**
+ * Snapshot whose strings live in a single arena allocation.
+ *
+ * View() is trivially copyable and stays valid for the lifetime of the
+ * PackedSnapshot. Copying a PackedSnapshot is one allocation and one
+ * memcpy, which makes it cheap to keep in caches or hand to other threads.
+ */
+class PackedSnapshot {
+public:
+    PackedSnapshot() = default;
+    explicit PackedSnapshot(const Snapshot& snapshot);
+    PackedSnapshot(const PackedSnapshot& other);
+    PackedSnapshot& operator=(const PackedSnapshot& other);
+    PackedSnapshot(PackedSnapshot&&) noexcept = default;
+    PackedSnapshot& operator=(PackedSnapshot&&) noexcept = default;
+
+    const SnapshotView& View() const { return view; }
+    Snapshot ToSnapshot() const;
+
+private:
+    std::unique_ptr<char[]> arena;
+    size_t arenaSize = 0;
+    SnapshotView view;
+};
+
+/**
+ * Snapshot categories, combined as a mask for GetSnapshot()
+ */
+enum Category : unsigned {
+    CATEGORY_BIOS = 1u << 0,
+    CATEGORY_SYSTEM = 1u << 1,
+    CATEGORY_BOARD = 1u << 2,
+    CATEGORY_PROCESSOR = 1u << 3,
+    CATEGORY_MEMORY = 1u << 4,
+    CATEGORY_CHASSIS = 1u << 5,
+    // Categories that do not change until reboot
+    CATEGORY_STATIC = CATEGORY_BIOS | CATEGORY_SYSTEM | CATEGORY_BOARD |
+                      CATEGORY_PROCESSOR | CATEGORY_CHASSIS,
+    CATEGORY_ALL = CATEGORY_STATIC | CATEGORY_MEMORY
+};
+
+/**
+ * Result of opening the cross-process shared snapshot
+ */
+struct SharedSnapshotInfo {
+    std::string path;
+    std::string bootId;
+    bool created = false;   // This process wrote the file
+};
+
+/**
+ * A field that differs between two snapshots ("category.field" path)
+ */
+struct FieldChange {
+    std::string path;
+    std::string oldValue;
+    std::string newValue;
+};
+
+/**
+ * Cache Information structure (SMBIOS type 7)
+ */
+struct CacheInfo {
+    std::string socketDesignation;
+    uint8_t level = 0;
+    bool enabled = false;
+    std::string location;
+    std::string operationalMode;
+    std::string cacheType;
+    std::string associativity;
+    std::string errorCorrection;
+    uint64_t installedSize = 0;     // Bytes
+    uint64_t maximumSize = 0;       // Bytes
+};
+
+/**
+ * Per-socket Processor structure (SMBIOS type 4)
+ */
+struct ProcessorSocket {
+    std::string socketDesignation;
+    std::string processorType;
+    std::string processorFamily;
+    std::string manufacturer;
+    std::string version;
+    std::string processorId;
+    std::string serialNumber;
+    std::string assetTag;
+    std::string partNumber;
+    std::string status;
+    bool populated = false;
+    double voltage = 0;             // Volts, 0 if unknown
+    uint16_t externalClock = 0;     // MHz
+    uint16_t maxSpeed = 0;          // MHz
+    uint16_t currentSpeed = 0;      // MHz
+    uint16_t coreCount = 0;
+    uint16_t coreEnabled = 0;
+    uint16_t threadCount = 0;
+    uint16_t threadEnabled = 0;
+    std::vector<CacheInfo> caches;  // Linked L1/L2/L3
+};
+
+/**
+ * PCI peer of a system slot (bifurcated or multi-function slots)
+ */
+struct SlotPeer {
+    uint16_t segment = 0;
+    uint8_t bus = 0;
+    uint8_t device = 0;
+    uint8_t function = 0;
+    uint8_t dataBusWidth = 0;
+};
+
+/**
+ * System Slot structure (SMBIOS type 9)
+ */
+struct SystemSlot {
+    std::string designation;
+    std::string slotType;
+    std::string dataBusWidth;
+    std::string physicalWidth;
+    std::string currentUsage;
+    std::string slotLength;
+    uint16_t slotId = 0;
+    uint16_t segment = 0xFFFF;
+    uint8_t bus = 0xFF;
+    uint8_t device = 0x1F;
+    uint8_t function = 0x07;
+    std::string pciAddress;
+    std::vector<SlotPeer> peers;
+};
+
+/**
+ * Onboard Device structure (SMBIOS type 41)
+ */
+struct OnboardDevice {
+    std::string referenceDesignation;
+    std::string deviceType;
+    bool enabled = false;
+    uint8_t instance = 0;
+    uint16_t segment = 0xFFFF;
+    uint8_t bus = 0xFF;
+    uint8_t device = 0x1F;
+    uint8_t function = 0x07;
+    std::string pciAddress;
+};
+
+/**
+ * Huge page pool of one size on a NUMA node
+ */
+struct HugePagePool {
+    uint64_t pageSize = 0;          // Bytes
+    uint64_t total = 0;             // Pages
+    uint64_t free = 0;              // Pages
+    uint64_t surplus = 0;           // Pages
+};
+
+/**
+ * NUMA node: CPUs, memory and distances to the other nodes
+ */
+struct NumaNode {
+    uint32_t id = 0;
+    std::vector<uint32_t> cpus;
+    uint64_t memTotal = 0;          // Bytes
+    uint64_t memFree = 0;           // Bytes
+    std::vector<uint32_t> distances; // Same order as the node list, empty if unknown
+    std::vector<HugePagePool> hugePages;
+};
+
+/**
+ * One CPU cache instance as seen by the OS, with the CPUs sharing it
+ */
+struct CacheInstance {
+    uint8_t level = 0;
+    std::string type;               // "Data", "Instruction" or "Unified"
+    uint64_t size = 0;              // Bytes
+    uint32_t lineSize = 0;          // Bytes
+    uint32_t ways = 0;              // 0 if unknown or fully associative
+    uint32_t sets = 0;
+    std::vector<uint32_t> cpus;
+    std::vector<uint32_t> cpuMask;  // Bit n of word n / 32 is set for CPU n
+};
+
+/**
+ * CPU and memory the current process can actually use: host totals
+ * narrowed by affinity, cgroup (Linux) or job object (Windows) limits
+ */
+struct EffectiveLimits {
+    std::string source;             // "cgroup2", "cgroup1", "job" or "" if none applies
+    uint32_t hostCpus = 0;          // Online logical CPUs
+    std::vector<uint32_t> cpus;     // CPUs this process may run on
+    double cpuQuota = 0;            // CPUs worth of time allowed, 0 if unlimited
+    uint32_t effectiveCpus = 0;     // What to size thread pools from
+    uint64_t hostMemory = 0;        // Bytes
+    uint64_t memoryLimit = 0;       // Bytes, 0 if unlimited
+    uint64_t memoryUsage = 0;       // Bytes charged to the cgroup/job, 0 if unknown
+    uint64_t effectiveMemory = 0;   // Bytes; min(hostMemory, memoryLimit)
+};
+
+/**
+ * CPU feature flags as a bitset; bit n is entry n of the feature table
+ * in smbios_cpu_features.h
+ */
+struct CpuFeatures {
+    static const size_t CAPACITY = 256;
+    uint64_t bits[CAPACITY / 64] = {};
+
+    bool Has(size_t feature) const {
+        return feature < CAPACITY && ((bits[feature / 64] >> (feature % 64)) & 1) != 0;
+    }
+    void Set(size_t feature) {
+        bits[feature / 64] |= uint64_t(1) << (feature % 64);
+    }
+};
+
+/**
+ * Thermal state derived from sensor readings; names follow the SMBIOS
+ * chassis state enumeration
+ */
+enum ThermalState {
+    THERMAL_STATE_UNKNOWN,
+    THERMAL_STATE_SAFE,
+    THERMAL_STATE_WARNING,
+    THERMAL_STATE_CRITICAL
+};
+
+/**
+ * Temperature sensor (hwmon channel or thermal zone) and its trip points
+ */
+struct ThermalSensor {
+    std::string source;             // "hwmon" or "thermal"
+    std::string name;               // hwmon chip (e.g. "coretemp") or thermal zone type
+    std::string label;              // e.g. "Package id 0", "Core 3"; the name if unlabeled
+    std::string kind;               // "package", "core" or "other"
+    int32_t package = -1;           // -1 if unknown
+    int32_t core = -1;              // -1 if not a core sensor
+    double warning = 0;             // °C, 0 if none (hwmon max, passive/hot trip)
+    double critical = 0;            // °C, 0 if none
+};
+
+/**
+ * Hypervisor the process runs under
+ */
+struct VirtualizationInfo {
+    bool virtualized = false;
+    std::string hypervisor;         // "kvm", "qemu", "vmware", "hyperv", "xen", "virtualbox",
+                                    // "parallels", "bhyve", "acrn", "amazon", "google" or
+                                    // "unknown"; "" on bare metal
+    std::string cpuidVendor;        // CPUID 0x40000000 signature, e.g. "KVMKVMKVM"
+    bool hypervisorBit = false;     // CPUID.1:ECX[31]
+    std::string source;             // Signal that decided: "cpuid", "smbios", "os" or ""
+};
+
+/**
+ * One category straight from the platform on every call, without the
+ * cache or placeholder cleanup; prefer GetSnapshot()
+ */
+BiosInfo GetBiosInfo();
+SystemInfo GetSystemInfo();
+BoardInfo GetBoardInfo();
+ProcessorInfo GetProcessorInfo();
+MemoryInfo GetMemoryInfo();
+ChassisInfo GetChassisInfo();
+
+/**
+ * Snapshot helpers built on the getters above. GetSnapshot() fills the
+ * requested categories; static ones are served from the shared snapshot
+ * while it is open and from the process-wide cache otherwise. Memory is
+ * always read live.
+ */
+Snapshot GetSnapshot(unsigned categories = CATEGORY_ALL);
+
+/**
+ * GetSnapshot() without the copies. The static fields are views into the
+ * shared or cached snapshot, which this object keeps alive; only the
+ * volatile fields (processor.currentSpeed, chassis.thermalState and
+ * memory) are read live and owned here. The views point into this
+ * object, so it can be neither copied nor moved.
+ */
+class SnapshotRef {
+public:
+    explicit SnapshotRef(unsigned categories = CATEGORY_ALL);
+    SnapshotRef(const SnapshotRef&) = delete;
+    SnapshotRef& operator=(const SnapshotRef&) = delete;
+
+    const SnapshotView& View() const { return view; }
+
+private:
+    std::shared_ptr<const SnapshotView> source;
+    std::string currentSpeed;
+    MemoryInfo memory;
+    SnapshotView view;
+};
+
+/**
+ * Process-wide cache of the static categories: each category is collected
+ * the first time it is requested and then shared by every caller until
+ * ClearSnapshotCache()
+ */
+std::shared_ptr<const PackedSnapshot> GetCachedSnapshot(unsigned categories = CATEGORY_STATIC);
+void ClearSnapshotCache();
+std::vector<FieldChange> DiffSnapshots(const Snapshot& oldSnapshot, const Snapshot& newSnapshot);
+
+/**
+ * Compact binary snapshot: "SMB", a version byte, a table of the distinct
+ * strings, then per category the non-empty fields as (field ID, value)
+ * varint pairs. Field and category IDs are positions in the descriptor
+ * tables; canonical decimal values are stored as varints instead of
+ * strings. Decoding skips IDs it does not know, so fields appended later
+ * stay readable. DeserializeSnapshot() returns false on malformed input.
+ */
+const uint8_t SNAPSHOT_FORMAT_VERSION = 1;
+std::vector<uint8_t> SerializeSnapshot(const Snapshot& snapshot);
+bool DeserializeSnapshot(const uint8_t* data, size_t size, Snapshot& snapshot);
+
+/**
+ * Cross-process shared snapshot of the static categories.
+ *
+ * The first process after boot collects the static categories and writes
+ * them to `path`; every other process maps the file read-only instead of
+ * re-reading DMI and /proc. The file is keyed by the boot ID and rebuilt
+ * automatically after a reboot. Throws std::runtime_error on failure.
+ *
+ * The file is world-readable and never holds the serial numbers or the
+ * system UUID; each process reads those itself. Everything else is
+ * whatever the building process could read, so build it from a
+ * privileged service (e.g. root at boot): an unprivileged builder leaves
+ * the root-only firmware fields blank for every reader.
+ *
+ * A file or lock file owned by another user (other than root), or
+ * writable by group or others, is never trusted: the snapshot is rebuilt
+ * and the lock refused, so a planted file cannot forge the inventory.
+ */
+const char* const DEFAULT_SHARED_SNAPSHOT_PATH = "/run/node-smbios/snapshot.bin";
+SharedSnapshotInfo OpenSharedSnapshot(const std::string& path = DEFAULT_SHARED_SNAPSHOT_PATH);
+void CloseSharedSnapshot();
+std::shared_ptr<const SnapshotView> GetSharedSnapshot();
+
+/**
+ * Decoded from the raw SMBIOS table on every platform
+ */
+std::vector<ProcessorSocket> GetProcessorSockets();
+std::vector<SystemSlot> GetSystemSlots();
+std::vector<OnboardDevice> GetOnboardDevices();
+
+/**
+ * Current frequency (MHz) of every online logical CPU, NaN where the
+ * platform does not report one. Reuses `mhz` and any state kept between
+ * calls, so it is cheap enough for periodic sampling.
+ */
+void SampleCpuFrequencies(std::vector<double>& mhz);
+
+/**
+ * Fixed slots of SampleMemoryStats(), all in bytes
+ */
+enum MemoryStat {
+    MEMORY_STAT_TOTAL,
+    MEMORY_STAT_FREE,
+    MEMORY_STAT_AVAILABLE,
+    MEMORY_STAT_BUFFERS,
+    MEMORY_STAT_CACHED,
+    MEMORY_STAT_SWAP_TOTAL,
+    MEMORY_STAT_SWAP_FREE,
+    MEMORY_STAT_COUNT
+};
+
+/**
+ * Platform-specific: current memory counters, NaN where the platform has
+ * no equivalent. Does not allocate.
+ */
+void SampleMemoryStats(double (&stats)[MEMORY_STAT_COUNT]);
+
+/**
+ * Busy/total time counters from one consumer's previous SampleCpuLoads()
+ * call. Every consumer (e.g. a polling loop, the metrics renderer) owns
+ * its own, so they do not shorten each other's intervals. Not for use
+ * from several threads at once.
+ */
+struct CpuLoadState {
+    struct Counters {
+        uint64_t total = 0;
+        uint64_t idle = 0;
+        double load = std::numeric_limits<double>::quiet_NaN();
+    };
+    Counters system;
+    std::vector<Counters> cpus;
+};
+
+/**
+ * Platform-specific: busy fraction (0..1) of every CPU since the previous
+ * call with the same `state`, indexed by CPU number, NaN where unknown.
+ * Returns the busy fraction of the whole system. Reuses `load` like
+ * SampleCpuFrequencies().
+ */
+double SampleCpuLoads(CpuLoadState& state, std::vector<double>& load);
+
+/**
+ * OpenMetrics text exposition: info metrics for the BIOS, system, board
+ * and chassis (without the FIELD_PRIVATE fields) plus memory, CPU and
+ * temperature gauges and the thermal state. The inventory part is
+ * rendered once per process; later calls only format the gauge values.
+ * Reuses the capacity of `out`.
+ */
+void RenderOpenMetrics(std::string& out);
+
+/**
+ * Platform-specific: temperature sensors, enumerated once per process.
+ * Empty where the platform exposes none to unprivileged processes.
+ */
+std::vector<ThermalSensor> GetThermalSensors();
+
+/**
+ * Platform-specific: current temperature (°C) of every sensor, in
+ * GetThermalSensors() order, NaN where a read fails. The sensor files are
+ * held open and read in one pass; `celsius` is reused like
+ * SampleCpuFrequencies(). Returns the worst state across sensors:
+ * Critical at or above a critical trip point, Warning at or above a
+ * warning one, Unknown without any reading.
+ */
+ThermalState SampleTemperatures(std::vector<double>& celsius);
+
+/**
+ * SMBIOS name of a state ("Unknown", "Safe", "Warning", "Critical")
+ */
+const char* ThermalStateName(ThermalState state);
+
+/**
+ * Platform-specific: online NUMA nodes, empty if the platform does not
+ * expose a NUMA layout
+ */
+std::vector<NumaNode> GetNumaNodes();
+
+/**
+ * Platform-specific: every cache instance once, ordered by level, type
+ * and first CPU; empty if the platform does not expose cache sharing
+ */
+std::vector<CacheInstance> GetCacheTopology();
+
+/**
+ * Platform-specific: limits of the calling process, re-read on every call
+ */
+EffectiveLimits GetEffectiveLimits();
+
+/**
+ * CPU features, detected once per process: from CPUID (checked against
+ * the register state the OS enables) on x86, from the flags the OS
+ * reports elsewhere. HasCpuFeature() is one hash lookup and one bit test.
+ */
+const CpuFeatures& GetCpuFeatures();
+bool HasCpuFeature(std::string_view name);
+std::vector<std::string> GetCpuFeatureNames();
+
+/**
+ * Virtualization environment, detected once per process. Signals are
+ * tried cheapest first: a known CPUID hypervisor vendor settles it with
+ * no I/O; otherwise the SMBIOS system/BIOS strings and VM flag, then
+ * what the OS reports.
+ */
+const VirtualizationInfo& GetVirtualization();
+
+} // namespace smbios
+
+#endif // SMBIOS_H
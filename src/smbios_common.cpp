@@ -1,7 +1,10 @@
 #include "smbios_common.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #ifdef _WIN32
@@ -17,6 +20,13 @@ namespace smbios {
  * Trim whitespace from both ends of a string
  */
 std::string TrimString(const std::string& str) {
+    return std::string(TrimView(str));
+}
+
+/**
+ * Trim whitespace from both ends of a string without copying it
+ */
+std::string_view TrimView(std::string_view str) {
     size_t start = 0;
     size_t end = str.length();
     
@@ -67,4 +77,80 @@ std::string ReadFile(const std::string& path) {
     return TrimString(content);
 }
 
+/**
+ * Read entire file contents as raw bytes
+ */
+std::vector<uint8_t> ReadBinaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+    
+    return std::vector<uint8_t>(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>()
+    );
+}
+
+/**
+ * Parse a kernel CPU list such as "0-3,8,10-11" into CPU numbers
+ */
+std::vector<uint32_t> ParseCpuList(const std::string& list) {
+    std::vector<uint32_t> cpus;
+    const char* p = list.c_str();
+    
+    while (*p) {
+        while (*p == ',' || std::isspace(static_cast<unsigned char>(*p))) {
+            p++;
+        }
+        if (!std::isdigit(static_cast<unsigned char>(*p))) {
+            break;
+        }
+        
+        char* end = nullptr;
+        unsigned long first = std::strtoul(p, &end, 10);
+        unsigned long last = first;
+        p = end;
+        if (*p == '-') {
+            last = std::strtoul(p + 1, &end, 10);
+            p = end;
+        }
+        for (unsigned long cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+    }
+    
+    return cpus;
+}
+
+/**
+ * Frequency in the /proc/cpuinfo "cpu MHz" format ("2100.000"), used for
+ * both processor speed fields on every platform
+ */
+std::string FormatMhz(double mhz) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", mhz);
+    return buffer;
+}
+
+double UpdateCpuLoad(CpuLoadState::Counters& previous, uint64_t total, uint64_t idle) {
+    if (total > previous.total) {
+        uint64_t deltaTotal = total - previous.total;
+        uint64_t deltaIdle = idle >= previous.idle ? idle - previous.idle : 0;
+        previous.load = deltaIdle >= deltaTotal ? 0.0 : double(deltaTotal - deltaIdle) / deltaTotal;
+    }
+    previous.total = total;
+    previous.idle = idle;
+    return previous.load;
+}
+
+const char* ThermalStateName(ThermalState state) {
+    switch (state) {
+        case THERMAL_STATE_SAFE: return "Safe";
+        case THERMAL_STATE_WARNING: return "Warning";
+        case THERMAL_STATE_CRITICAL: return "Critical";
+        default: return "Unknown";
+    }
+}
+
 } // namespace smbios
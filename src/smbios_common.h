@@ -1,106 +1,69 @@
 #ifndef SMBIOS_COMMON_H
 #define SMBIOS_COMMON_H
 
-#include <string>
-#include <vector>
+// Internal declarations shared by the smbios-core sources: platform hooks
+// and helpers that are not part of the public API in smbios.h. The
+// platform files (src/linux, src/mac, src/windows) implement the
+// platform-specific functions of both headers.
 
-namespace smbios {
+#include "smbios.h"
 
-/**
- * BIOS Information structure
- */
-struct BiosInfo {
-    std::string vendor;
-    std::string version;
-    std::string releaseDate;
-    std::string biosCharacteristics;
-};
+namespace smbios {
 
 /**
- * System Information structure
+ * Boot-up, power supply and thermal state recorded by the firmware in the
+ * Chassis structure (SMBIOS type 3); "" where the table is not readable
  */
-struct SystemInfo {
-    std::string manufacturer;
-    std::string productName;
-    std::string serialNumber;
-    std::string uuid;
-    std::string skuNumber;
-    std::string family;
-    std::string wakeUpType;
+struct ChassisStates {
+    std::string bootUp;
+    std::string powerSupply;
+    std::string thermal;
 };
 
-/**
- * Board/Baseboard Information structure
- */
-struct BoardInfo {
-    std::string manufacturer;
-    std::string product;
-    std::string version;
-    std::string serialNumber;
-    std::string assetTag;
-    std::string locationInChassis;
-};
+ChassisStates GetChassisStates();
 
 /**
- * Processor Information structure
+ * Platform-specific: identifier of the current boot, "" if unsupported
  */
-struct ProcessorInfo {
-    std::string manufacturer;
-    std::string version;
-    std::string socketDesignation;
-    std::string processorType;
-    std::string processorFamily;
-    std::string maxSpeed;
-    std::string currentSpeed;
-    std::string coreCount;
-    std::string threadCount;
-    std::string l2CacheSize;
-    std::string l3CacheSize;
-};
+std::string GetBootId();
 
 /**
- * Memory Information structure
+ * Platform-specific (Linux, macOS): the FIELD_PRIVATE fields (serial
+ * numbers, system UUID) as far as this process may read them. They are
+ * left out of the shared snapshot, so every process reads its own.
  */
-struct MemoryInfo {
-    std::string totalPhysicalMemory;
-    std::string availablePhysicalMemory;
-    std::string totalVirtualMemory;
-    std::string availableVirtualMemory;
-    std::string memoryDevices;
-    std::string maxCapacity;
-};
+void ReadPrivateFields(Snapshot& snapshot);
 
 /**
- * Chassis Information structure
+ * Platform-specific: CPU flags as the OS reports them, space separated
+ * (/proc/cpuinfo names). Only consulted where CPUID is not available.
  */
-struct ChassisInfo {
-    std::string manufacturer;
-    std::string type;
-    std::string version;
-    std::string serialNumber;
-    std::string assetTag;
-    std::string bootUpState;
-    std::string powerSupplyState;
-    std::string thermalState;
-};
+std::string ReadCpuFlags();
 
 /**
- * Platform-specific implementations
- * These functions must be implemented for each platform
+ * Platform-specific: hypervisor the OS itself reports ("xen", "kvm"),
+ * "unknown" if it only reports that there is one, "" otherwise. Cheap
+ * reads only (/sys/hypervisor, device tree, sysctl).
  */
-BiosInfo GetBiosInfo();
-SystemInfo GetSystemInfo();
-BoardInfo GetBoardInfo();
-ProcessorInfo GetProcessorInfo();
-MemoryInfo GetMemoryInfo();
-ChassisInfo GetChassisInfo();
+std::string ReadHypervisorHint();
 
 /**
  * Utility functions
  */
 std::string TrimString(const std::string& str);
+std::string_view TrimView(std::string_view str);
 bool FileExists(const std::string& path);
 std::string ReadFile(const std::string& path);
+std::vector<uint8_t> ReadBinaryFile(const std::string& path);
+std::vector<uint32_t> ParseCpuList(const std::string& list);
+std::string FormatMhz(double mhz);
+
+/**
+ * Busy fraction since `previous` from cumulative total and idle time,
+ * then advance `previous`. Two samples within one tick repeat the last
+ * value.
+ */
+double UpdateCpuLoad(CpuLoadState::Counters& previous, uint64_t total, uint64_t idle);
 
 } // namespace smbios
 
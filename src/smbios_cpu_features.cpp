@@ -0,0 +1,109 @@
+#include "smbios_common.h"
+#include "smbios_cpu_features.h"
+#include "smbios_cpuid.h"
+#include <cctype>
+
+namespace smbios {
+
+namespace {
+
+#ifdef SMBIOS_HAVE_CPUID
+
+/**
+ * XCR0 bits each XState requires
+ */
+uint64_t RequiredXcr0(cpu_features::XState xstate) {
+    switch (xstate) {
+        case cpu_features::XSTATE_AVX: return 0x06;
+        case cpu_features::XSTATE_AVX512: return 0xE6;
+        case cpu_features::XSTATE_AMX: return 0x60000;
+        default: return 0;
+    }
+}
+
+CpuFeatures DetectFromCpuid() {
+    CpuFeatures features;
+    const uint32_t maxStandard = CpuidMaxLeaf(0);
+    const uint32_t maxExtended = CpuidMaxLeaf(0x80000000);
+    const uint64_t xcr0 = ReadXcr0();
+
+    // One CPUID per distinct leaf/subleaf; the table is grouped by leaf
+    uint32_t lastLeaf = 0;
+    uint8_t lastSubleaf = 0;
+    CpuidRegisters regs;
+    for (size_t i = 0; i < cpu_features::COUNT; i++) {
+        const cpu_features::Feature& feature = cpu_features::LIST[i];
+        if (feature.leaf == 0) {
+            continue;
+        }
+        uint32_t max = feature.leaf >= 0x80000000 ? maxExtended : maxStandard;
+        if (feature.leaf > max) {
+            continue;
+        }
+        if (feature.leaf != lastLeaf || feature.subleaf != lastSubleaf) {
+            regs = Cpuid(feature.leaf, feature.subleaf);
+            lastLeaf = feature.leaf;
+            lastSubleaf = feature.subleaf;
+        }
+
+        const uint32_t values[] = { regs.eax, regs.ebx, regs.ecx, regs.edx };
+        uint64_t required = RequiredXcr0(feature.xstate);
+        if (((values[feature.reg] >> feature.bit) & 1) && (xcr0 & required) == required) {
+            features.Set(i);
+        }
+    }
+    return features;
+}
+
+#else
+
+CpuFeatures DetectFromFlags(const std::string& flags) {
+    CpuFeatures features;
+    size_t pos = 0;
+    while (pos < flags.size()) {
+        while (pos < flags.size() && std::isspace(static_cast<unsigned char>(flags[pos]))) {
+            pos++;
+        }
+        size_t end = pos;
+        while (end < flags.size() && !std::isspace(static_cast<unsigned char>(flags[end]))) {
+            end++;
+        }
+        int feature = cpu_features::Find(std::string_view(flags).substr(pos, end - pos));
+        if (feature >= 0) {
+            features.Set(static_cast<size_t>(feature));
+        }
+        pos = end;
+    }
+    return features;
+}
+
+#endif // SMBIOS_HAVE_CPUID
+
+} // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+#ifdef SMBIOS_HAVE_CPUID
+    static const CpuFeatures features = DetectFromCpuid();
+#else
+    static const CpuFeatures features = DetectFromFlags(ReadCpuFlags());
+#endif
+    return features;
+}
+
+bool HasCpuFeature(std::string_view name) {
+    int feature = cpu_features::Find(name);
+    return feature >= 0 && GetCpuFeatures().Has(static_cast<size_t>(feature));
+}
+
+std::vector<std::string> GetCpuFeatureNames() {
+    std::vector<std::string> names;
+    const CpuFeatures& features = GetCpuFeatures();
+    for (size_t i = 0; i < cpu_features::COUNT; i++) {
+        if (features.Has(i)) {
+            names.emplace_back(cpu_features::LIST[i].name);
+        }
+    }
+    return names;
+}
+
+} // namespace smbios
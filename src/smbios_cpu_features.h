@@ -0,0 +1,198 @@
+#ifndef SMBIOS_CPU_FEATURES_H
+#define SMBIOS_CPU_FEATURES_H
+
+#include "smbios_common.h"
+#include "smbios_perfect_hash.h"
+#include <array>
+#include <string_view>
+
+namespace smbios {
+
+namespace cpu_features {
+
+enum Register : uint8_t { EAX, EBX, ECX, EDX };
+
+/**
+ * Register state the OS must have enabled in XCR0 for a feature to be
+ * usable, beyond the CPUID bit itself
+ */
+enum XState : uint8_t {
+    XSTATE_NONE,
+    XSTATE_AVX,         // XMM | YMM
+    XSTATE_AVX512,      // XMM | YMM | opmask | ZMM_Hi256 | Hi16_ZMM
+    XSTATE_AMX          // XTILECFG | XTILEDATA
+};
+
+/**
+ * A feature flag and, on x86, where CPUID reports it. Leaf 0 means the
+ * flag only comes from the OS (e.g. the ARM "Features" line).
+ */
+struct Feature {
+    std::string_view name;
+    uint32_t leaf;
+    uint8_t subleaf;
+    Register reg;
+    uint8_t bit;
+    XState xstate;
+};
+
+/**
+ * Names follow /proc/cpuinfo. The position in this table is the bit
+ * index in CpuFeatures, so only append.
+ */
+constexpr Feature LIST[] = {
+    // CPUID.1:EDX
+    { "fpu", 1, 0, EDX, 0, XSTATE_NONE },
+    { "tsc", 1, 0, EDX, 4, XSTATE_NONE },
+    { "cx8", 1, 0, EDX, 8, XSTATE_NONE },
+    { "cmov", 1, 0, EDX, 15, XSTATE_NONE },
+    { "clflush", 1, 0, EDX, 19, XSTATE_NONE },
+    { "mmx", 1, 0, EDX, 23, XSTATE_NONE },
+    { "fxsr", 1, 0, EDX, 24, XSTATE_NONE },
+    { "sse", 1, 0, EDX, 25, XSTATE_NONE },
+    { "sse2", 1, 0, EDX, 26, XSTATE_NONE },
+    { "ht", 1, 0, EDX, 28, XSTATE_NONE },
+    // CPUID.1:ECX
+    { "pni", 1, 0, ECX, 0, XSTATE_NONE },
+    { "pclmulqdq", 1, 0, ECX, 1, XSTATE_NONE },
+    { "ssse3", 1, 0, ECX, 9, XSTATE_NONE },
+    { "fma", 1, 0, ECX, 12, XSTATE_AVX },
+    { "cx16", 1, 0, ECX, 13, XSTATE_NONE },
+    { "sse4_1", 1, 0, ECX, 19, XSTATE_NONE },
+    { "sse4_2", 1, 0, ECX, 20, XSTATE_NONE },
+    { "movbe", 1, 0, ECX, 22, XSTATE_NONE },
+    { "popcnt", 1, 0, ECX, 23, XSTATE_NONE },
+    { "aes", 1, 0, ECX, 25, XSTATE_NONE },
+    { "xsave", 1, 0, ECX, 26, XSTATE_NONE },
+    { "avx", 1, 0, ECX, 28, XSTATE_AVX },
+    { "f16c", 1, 0, ECX, 29, XSTATE_AVX },
+    { "rdrand", 1, 0, ECX, 30, XSTATE_NONE },
+    { "hypervisor", 1, 0, ECX, 31, XSTATE_NONE },
+    // CPUID.7.0:EBX
+    { "fsgsbase", 7, 0, EBX, 0, XSTATE_NONE },
+    { "bmi1", 7, 0, EBX, 3, XSTATE_NONE },
+    { "hle", 7, 0, EBX, 4, XSTATE_NONE },
+    { "avx2", 7, 0, EBX, 5, XSTATE_AVX },
+    { "bmi2", 7, 0, EBX, 8, XSTATE_NONE },
+    { "erms", 7, 0, EBX, 9, XSTATE_NONE },
+    { "rtm", 7, 0, EBX, 11, XSTATE_NONE },
+    { "avx512f", 7, 0, EBX, 16, XSTATE_AVX512 },
+    { "avx512dq", 7, 0, EBX, 17, XSTATE_AVX512 },
+    { "rdseed", 7, 0, EBX, 18, XSTATE_NONE },
+    { "adx", 7, 0, EBX, 19, XSTATE_NONE },
+    { "avx512ifma", 7, 0, EBX, 21, XSTATE_AVX512 },
+    { "clflushopt", 7, 0, EBX, 23, XSTATE_NONE },
+    { "clwb", 7, 0, EBX, 24, XSTATE_NONE },
+    { "avx512pf", 7, 0, EBX, 26, XSTATE_AVX512 },
+    { "avx512er", 7, 0, EBX, 27, XSTATE_AVX512 },
+    { "avx512cd", 7, 0, EBX, 28, XSTATE_AVX512 },
+    { "sha_ni", 7, 0, EBX, 29, XSTATE_NONE },
+    { "avx512bw", 7, 0, EBX, 30, XSTATE_AVX512 },
+    { "avx512vl", 7, 0, EBX, 31, XSTATE_AVX512 },
+    // CPUID.7.0:ECX
+    { "avx512vbmi", 7, 0, ECX, 1, XSTATE_AVX512 },
+    { "umip", 7, 0, ECX, 2, XSTATE_NONE },
+    { "pku", 7, 0, ECX, 3, XSTATE_NONE },
+    { "waitpkg", 7, 0, ECX, 5, XSTATE_NONE },
+    { "avx512_vbmi2", 7, 0, ECX, 6, XSTATE_AVX512 },
+    { "gfni", 7, 0, ECX, 8, XSTATE_NONE },
+    { "vaes", 7, 0, ECX, 9, XSTATE_AVX },
+    { "vpclmulqdq", 7, 0, ECX, 10, XSTATE_AVX },
+    { "avx512_vnni", 7, 0, ECX, 11, XSTATE_AVX512 },
+    { "avx512_bitalg", 7, 0, ECX, 12, XSTATE_AVX512 },
+    { "avx512_vpopcntdq", 7, 0, ECX, 14, XSTATE_AVX512 },
+    { "rdpid", 7, 0, ECX, 22, XSTATE_NONE },
+    { "movdiri", 7, 0, ECX, 27, XSTATE_NONE },
+    { "movdir64b", 7, 0, ECX, 28, XSTATE_NONE },
+    // CPUID.7.0:EDX
+    { "avx512_4vnniw", 7, 0, EDX, 2, XSTATE_AVX512 },
+    { "avx512_4fmaps", 7, 0, EDX, 3, XSTATE_AVX512 },
+    { "fsrm", 7, 0, EDX, 4, XSTATE_NONE },
+    { "avx512_vp2intersect", 7, 0, EDX, 8, XSTATE_AVX512 },
+    { "serialize", 7, 0, EDX, 14, XSTATE_NONE },
+    { "amx_bf16", 7, 0, EDX, 22, XSTATE_AMX },
+    { "avx512_fp16", 7, 0, EDX, 23, XSTATE_AVX512 },
+    { "amx_tile", 7, 0, EDX, 24, XSTATE_AMX },
+    { "amx_int8", 7, 0, EDX, 25, XSTATE_AMX },
+    // CPUID.7.1:EAX
+    { "avx_vnni", 7, 1, EAX, 4, XSTATE_AVX },
+    { "avx512_bf16", 7, 1, EAX, 5, XSTATE_AVX512 },
+    // CPUID.0xD.1:EAX
+    { "xsaveopt", 0xD, 1, EAX, 0, XSTATE_NONE },
+    { "xsavec", 0xD, 1, EAX, 1, XSTATE_NONE },
+    { "xsaves", 0xD, 1, EAX, 3, XSTATE_NONE },
+    // CPUID.0x80000001:ECX/EDX
+    { "lahf_lm", 0x80000001, 0, ECX, 0, XSTATE_NONE },
+    { "abm", 0x80000001, 0, ECX, 5, XSTATE_NONE },
+    { "sse4a", 0x80000001, 0, ECX, 6, XSTATE_NONE },
+    { "xop", 0x80000001, 0, ECX, 11, XSTATE_AVX },
+    { "fma4", 0x80000001, 0, ECX, 16, XSTATE_AVX },
+    { "syscall", 0x80000001, 0, EDX, 11, XSTATE_NONE },
+    { "nx", 0x80000001, 0, EDX, 20, XSTATE_NONE },
+    { "pdpe1gb", 0x80000001, 0, EDX, 26, XSTATE_NONE },
+    { "rdtscp", 0x80000001, 0, EDX, 27, XSTATE_NONE },
+    { "lm", 0x80000001, 0, EDX, 29, XSTATE_NONE },
+    // ARM (HWCAP names), OS-reported only
+    { "fp", 0, 0, EAX, 0, XSTATE_NONE },
+    { "asimd", 0, 0, EAX, 0, XSTATE_NONE },
+    { "evtstrm", 0, 0, EAX, 0, XSTATE_NONE },
+    { "pmull", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sha1", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sha2", 0, 0, EAX, 0, XSTATE_NONE },
+    { "crc32", 0, 0, EAX, 0, XSTATE_NONE },
+    { "atomics", 0, 0, EAX, 0, XSTATE_NONE },
+    { "fphp", 0, 0, EAX, 0, XSTATE_NONE },
+    { "asimdhp", 0, 0, EAX, 0, XSTATE_NONE },
+    { "cpuid", 0, 0, EAX, 0, XSTATE_NONE },
+    { "asimdrdm", 0, 0, EAX, 0, XSTATE_NONE },
+    { "jscvt", 0, 0, EAX, 0, XSTATE_NONE },
+    { "fcma", 0, 0, EAX, 0, XSTATE_NONE },
+    { "lrcpc", 0, 0, EAX, 0, XSTATE_NONE },
+    { "dcpop", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sha3", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sm3", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sm4", 0, 0, EAX, 0, XSTATE_NONE },
+    { "asimddp", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sha512", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sve", 0, 0, EAX, 0, XSTATE_NONE },
+    { "asimdfhm", 0, 0, EAX, 0, XSTATE_NONE },
+    { "dit", 0, 0, EAX, 0, XSTATE_NONE },
+    { "uscat", 0, 0, EAX, 0, XSTATE_NONE },
+    { "ilrcpc", 0, 0, EAX, 0, XSTATE_NONE },
+    { "flagm", 0, 0, EAX, 0, XSTATE_NONE },
+    { "ssbs", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sb", 0, 0, EAX, 0, XSTATE_NONE },
+    { "paca", 0, 0, EAX, 0, XSTATE_NONE },
+    { "pacg", 0, 0, EAX, 0, XSTATE_NONE },
+    { "sve2", 0, 0, EAX, 0, XSTATE_NONE },
+    { "bf16", 0, 0, EAX, 0, XSTATE_NONE },
+    { "i8mm", 0, 0, EAX, 0, XSTATE_NONE },
+};
+constexpr size_t COUNT = sizeof(LIST) / sizeof(LIST[0]);
+static_assert(COUNT <= CpuFeatures::CAPACITY, "CpuFeatures bitset is too small");
+
+template <size_t N>
+constexpr std::array<std::string_view, N> NamesOf(const Feature (&features)[N]) {
+    std::array<std::string_view, N> names = {};
+    for (size_t i = 0; i < N; i++) {
+        names[i] = features[i].name;
+    }
+    return names;
+}
+
+inline constexpr std::array<std::string_view, COUNT> NAMES = NamesOf(LIST);
+inline constexpr perfect_hash::Table<4096> TABLE = perfect_hash::Build<4096>(NAMES.data(), COUNT);
+static_assert(TABLE.valid, "No perfect hash seed found for the CPU feature names (or a name is not lowercase)");
+
+/**
+ * Bit index of a feature name, or -1 if unknown
+ */
+constexpr int Find(std::string_view name) {
+    return TABLE.Find(name, NAMES.data());
+}
+
+} // namespace cpu_features
+
+} // namespace smbios
+
+#endif // SMBIOS_CPU_FEATURES_H
@@ -0,0 +1,155 @@
+#include "smbios_common.h"
+#include "smbios_cpuid.h"
+#include <cstring>
+
+namespace smbios {
+
+#ifdef SMBIOS_HAVE_CPUID
+
+namespace {
+
+/**
+ * SMT and package widths from the extended topology leaf (0x1F or 0xB).
+ * Each subleaf describes one level; EBX is the number of logical
+ * processors up to and including that level. False if the leaf is empty.
+ */
+bool ReadTopology(uint32_t leaf, CpuidProcessor& info) {
+    for (uint32_t subleaf = 0; subleaf < 8; subleaf++) {
+        CpuidRegisters regs = Cpuid(leaf, subleaf);
+        uint32_t levelType = (regs.ecx >> 8) & 0xFF;
+        uint32_t count = regs.ebx & 0xFFFF;
+        if (levelType == 0 || count == 0) {
+            break;
+        }
+        if (levelType == 1) {
+            info.threadsPerCore = count;
+        }
+        info.logicalPerPackage = count;
+    }
+    return info.logicalPerPackage != 0;
+}
+
+/**
+ * L2/L3 sizes from a deterministic cache parameters leaf (4 on Intel,
+ * 0x8000001D on AMD). False if the leaf lists no caches.
+ */
+bool ReadCaches(uint32_t leaf, CpuidProcessor& info) {
+    bool found = false;
+    for (uint32_t subleaf = 0; subleaf < 16; subleaf++) {
+        CpuidRegisters regs = Cpuid(leaf, subleaf);
+        uint32_t type = regs.eax & 0x1F;
+        if (type == 0) {
+            break;
+        }
+        found = true;
+        if (type == 2) {
+            continue;   // Instruction cache
+        }
+
+        uint64_t ways = ((regs.ebx >> 22) & 0x3FF) + 1;
+        uint64_t partitions = ((regs.ebx >> 12) & 0x3FF) + 1;
+        uint64_t lineSize = (regs.ebx & 0xFFF) + 1;
+        uint64_t sets = static_cast<uint64_t>(regs.ecx) + 1;
+        uint64_t size = ways * partitions * lineSize * sets;
+        switch ((regs.eax >> 5) & 0x7) {
+            case 2: info.l2Size = size; break;
+            case 3: info.l3Size = size; break;
+        }
+    }
+    return found;
+}
+
+CpuidProcessor Decode() {
+    CpuidProcessor info;
+    const uint32_t maxStandard = CpuidMaxLeaf(0);
+    const uint32_t maxExtended = CpuidMaxLeaf(0x80000000);
+
+    CpuidRegisters regs = Cpuid(0);
+    char vendor[12];
+    std::memcpy(vendor, &regs.ebx, 4);
+    std::memcpy(vendor + 4, &regs.edx, 4);
+    std::memcpy(vendor + 8, &regs.ecx, 4);
+    info.vendor.assign(vendor, sizeof(vendor));
+    const bool amd = info.vendor == "AuthenticAMD" || info.vendor == "HygonGenuine";
+
+    if (maxExtended >= 0x80000004) {
+        char brand[48];
+        for (uint32_t i = 0; i < 3; i++) {
+            regs = Cpuid(0x80000002 + i);
+            std::memcpy(brand + 16 * i, &regs, 16);
+        }
+        info.brand = std::string(TrimView(std::string_view(brand, strnlen(brand, sizeof(brand)))));
+    }
+
+    // Display family/model: the extended fields only apply to family 0xF
+    // (and model to family 6)
+    regs = Cpuid(1);
+    uint32_t baseFamily = (regs.eax >> 8) & 0xF;
+    uint32_t baseModel = (regs.eax >> 4) & 0xF;
+    info.family = baseFamily == 0xF ? baseFamily + ((regs.eax >> 20) & 0xFF) : baseFamily;
+    info.model = baseFamily == 0x6 || baseFamily == 0xF
+        ? baseModel + (((regs.eax >> 16) & 0xF) << 4) : baseModel;
+    info.stepping = regs.eax & 0xF;
+    const uint32_t leaf1Logical = (regs.edx & (1u << 28)) ? (regs.ebx >> 16) & 0xFF : 1;
+
+    bool topology = (maxStandard >= 0x1F && ReadTopology(0x1F, info)) ||
+                    (maxStandard >= 0xB && ReadTopology(0xB, info));
+    if (!topology) {
+        // Legacy: logical count from leaf 1, cores from leaf 4 (Intel) or
+        // 0x80000008 (AMD)
+        uint32_t cores = 1;
+        if (amd && maxExtended >= 0x80000008) {
+            cores = (Cpuid(0x80000008).ecx & 0xFF) + 1;
+        } else if (!amd && maxStandard >= 4) {
+            cores = (Cpuid(4).eax >> 26) + 1;
+        }
+        info.logicalPerPackage = leaf1Logical;
+        info.threadsPerCore = leaf1Logical >= cores ? leaf1Logical / cores : 1;
+    }
+    if (info.threadsPerCore == 0) {
+        info.threadsPerCore = 1;
+    }
+    // On hybrid parts the SMT level only describes the current core's
+    // type (e.g. 8P+16E reads as 16 or 32 cores), so no core count
+    info.hybrid = maxStandard >= 7 && (Cpuid(7).edx & (1u << 15)) != 0;
+    if (!info.hybrid) {
+        info.coresPerPackage = info.logicalPerPackage / info.threadsPerCore;
+    }
+
+    if (maxStandard >= 0x16) {
+        regs = Cpuid(0x16);
+        info.baseMhz = regs.eax & 0xFFFF;
+        info.maxMhz = regs.ebx & 0xFFFF;
+    }
+
+    const bool topologyExtensions = maxExtended >= 0x80000001 && (Cpuid(0x80000001).ecx & (1u << 22));
+    bool caches = amd ? topologyExtensions && maxExtended >= 0x8000001D && ReadCaches(0x8000001D, info)
+                      : maxStandard >= 4 && ReadCaches(4, info);
+    if (!caches && maxExtended >= 0x80000006) {
+        regs = Cpuid(0x80000006);
+        info.l2Size = static_cast<uint64_t>(regs.ecx >> 16) * 1024;
+        info.l3Size = static_cast<uint64_t>((regs.edx >> 18) & 0x3FFF) * 512 * 1024;
+    }
+    if (info.hybrid) {
+        info.l2Size = 0;    // Differs between P- and E-cores
+    }
+
+    return info;
+}
+
+} // namespace
+
+const CpuidProcessor* GetCpuidProcessor() {
+    static const CpuidProcessor info = Decode();
+    return &info;
+}
+
+#else
+
+const CpuidProcessor* GetCpuidProcessor() {
+    return nullptr;
+}
+
+#endif // SMBIOS_HAVE_CPUID
+
+} // namespace smbios
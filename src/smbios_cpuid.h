@@ -0,0 +1,103 @@
+#ifndef SMBIOS_CPUID_H
+#define SMBIOS_CPUID_H
+
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SMBIOS_HAVE_CPUID 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace smbios {
+
+/**
+ * Registers returned by one CPUID leaf/subleaf
+ */
+struct CpuidRegisters {
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+};
+
+#ifdef SMBIOS_HAVE_CPUID
+
+inline CpuidRegisters Cpuid(uint32_t leaf, uint32_t subleaf = 0) {
+    CpuidRegisters regs;
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    regs.eax = static_cast<uint32_t>(values[0]);
+    regs.ebx = static_cast<uint32_t>(values[1]);
+    regs.ecx = static_cast<uint32_t>(values[2]);
+    regs.edx = static_cast<uint32_t>(values[3]);
+#else
+    __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+#endif
+    return regs;
+}
+
+/**
+ * Highest supported standard (0) or extended (0x80000000) leaf
+ */
+inline uint32_t CpuidMaxLeaf(uint32_t base) {
+    return Cpuid(base).eax;
+}
+
+/**
+ * XCR0: register state the OS saves on context switch. Zero when XGETBV
+ * is unavailable (CPUID.1:ECX.OSXSAVE clear).
+ */
+inline uint64_t ReadXcr0() {
+    if (!(Cpuid(1).ecx & (1u << 27))) {
+        return 0;
+    }
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+#endif // SMBIOS_HAVE_CPUID
+
+/**
+ * Processor identification decoded from CPUID. Leaves such as the
+ * topology and cache ones describe the core the decoding thread runs on.
+ * That is the same for every core except on hybrid parts (P- and
+ * E-cores), where the core count and L2 size are left 0 for the caller
+ * to take from the OS.
+ */
+struct CpuidProcessor {
+    std::string vendor;             // e.g. "GenuineIntel", "AuthenticAMD"
+    std::string brand;              // Brand string, trimmed
+    uint32_t family = 0;            // Display family/model (extended fields applied)
+    uint32_t model = 0;
+    uint32_t stepping = 0;
+    bool hybrid = false;            // CPUID.7.0:EDX[15], mixed core types
+    uint32_t threadsPerCore = 0;    // Of the decoding core's type
+    uint32_t logicalPerPackage = 0;
+    uint32_t coresPerPackage = 0;   // 0 if hybrid
+    uint32_t baseMhz = 0;           // Leaf 0x16, 0 if not reported
+    uint32_t maxMhz = 0;
+    uint64_t l2Size = 0;            // Bytes, 0 if unknown or hybrid
+    uint64_t l3Size = 0;
+};
+
+/**
+ * CPUID identification, decoded once per process. Null where CPUID is
+ * not available (non-x86).
+ */
+const CpuidProcessor* GetCpuidProcessor();
+
+} // namespace smbios
+
+#endif // SMBIOS_CPUID_H
@@ -0,0 +1,164 @@
+#ifndef SMBIOS_FIELDS_H
+#define SMBIOS_FIELDS_H
+
+#include "smbios.h"
+#include <cstddef>
+
+namespace smbios {
+
+/**
+ * Field descriptor flags
+ */
+enum FieldFlags : unsigned {
+    // Only privileged processes can read it (root-only in sysfs); never
+    // stored in the world-readable shared snapshot
+    FIELD_PRIVATE = 1u << 0,
+    // Vendor, product, version, serial, asset tag, UUID or SKU string;
+    // OEM placeholders in it are cleared (NormalizeInfo())
+    FIELD_IDENTITY = 1u << 1,
+};
+
+/**
+ * Field descriptor: JavaScript property name, struct member and flags
+ */
+template <typename T>
+struct FieldDescriptor {
+    const char* name;
+    typename T::string_type T::*member;
+    unsigned flags = 0;
+};
+
+/**
+ * Field tables for the info structs, in the order they are exposed to
+ * JavaScript. Anything that walks a struct generically (conversion,
+ * diffing, serialization) goes through these. A field's position is its
+ * ID in SerializeSnapshot() output, so only append.
+ */
+template <typename T>
+struct Fields;
+
+template <typename Str>
+struct Fields<BasicBiosInfo<Str>> {
+    using T = BasicBiosInfo<Str>;
+    static constexpr FieldDescriptor<T> list[] = {
+        { "vendor", &T::vendor, FIELD_IDENTITY },
+        { "version", &T::version, FIELD_IDENTITY },
+        { "releaseDate", &T::releaseDate },
+        { "biosCharacteristics", &T::biosCharacteristics },
+    };
+};
+
+template <typename Str>
+struct Fields<BasicSystemInfo<Str>> {
+    using T = BasicSystemInfo<Str>;
+    static constexpr FieldDescriptor<T> list[] = {
+        { "manufacturer", &T::manufacturer, FIELD_IDENTITY },
+        { "productName", &T::productName, FIELD_IDENTITY },
+        { "serialNumber", &T::serialNumber, FIELD_PRIVATE | FIELD_IDENTITY },
+        { "uuid", &T::uuid, FIELD_PRIVATE | FIELD_IDENTITY },
+        { "skuNumber", &T::skuNumber, FIELD_IDENTITY },
+        { "family", &T::family, FIELD_IDENTITY },
+        { "wakeUpType", &T::wakeUpType },
+    };
+};
+
+template <typename Str>
+struct Fields<BasicBoardInfo<Str>> {
+    using T = BasicBoardInfo<Str>;
+    static constexpr FieldDescriptor<T> list[] = {
+        { "manufacturer", &T::manufacturer, FIELD_IDENTITY },
+        { "product", &T::product, FIELD_IDENTITY },
+        { "version", &T::version, FIELD_IDENTITY },
+        { "serialNumber", &T::serialNumber, FIELD_PRIVATE | FIELD_IDENTITY },
+        { "assetTag", &T::assetTag, FIELD_IDENTITY },
+        { "locationInChassis", &T::locationInChassis },
+    };
+};
+
+template <typename Str>
+struct Fields<BasicProcessorInfo<Str>> {
+    using T = BasicProcessorInfo<Str>;
+    static constexpr FieldDescriptor<T> list[] = {
+        { "manufacturer", &T::manufacturer, FIELD_IDENTITY },
+        { "version", &T::version, FIELD_IDENTITY },
+        { "socketDesignation", &T::socketDesignation },
+        { "processorType", &T::processorType },
+        { "processorFamily", &T::processorFamily },
+        { "maxSpeed", &T::maxSpeed },
+        { "currentSpeed", &T::currentSpeed },
+        { "coreCount", &T::coreCount },
+        { "threadCount", &T::threadCount },
+        { "l2CacheSize", &T::l2CacheSize },
+        { "l3CacheSize", &T::l3CacheSize },
+    };
+};
+
+template <typename Str>
+struct Fields<BasicMemoryInfo<Str>> {
+    using T = BasicMemoryInfo<Str>;
+    static constexpr FieldDescriptor<T> list[] = {
+        { "totalPhysicalMemory", &T::totalPhysicalMemory },
+        { "availablePhysicalMemory", &T::availablePhysicalMemory },
+        { "totalVirtualMemory", &T::totalVirtualMemory },
+        { "availableVirtualMemory", &T::availableVirtualMemory },
+        { "memoryDevices", &T::memoryDevices },
+        { "maxCapacity", &T::maxCapacity },
+    };
+};
+
+template <typename Str>
+struct Fields<BasicChassisInfo<Str>> {
+    using T = BasicChassisInfo<Str>;
+    static constexpr FieldDescriptor<T> list[] = {
+        { "manufacturer", &T::manufacturer, FIELD_IDENTITY },
+        { "type", &T::type },
+        { "version", &T::version, FIELD_IDENTITY },
+        { "serialNumber", &T::serialNumber, FIELD_PRIVATE | FIELD_IDENTITY },
+        { "assetTag", &T::assetTag, FIELD_IDENTITY },
+        { "bootUpState", &T::bootUpState },
+        { "powerSupplyState", &T::powerSupplyState },
+        { "thermalState", &T::thermalState },
+    };
+};
+
+/**
+ * Call f(descriptor) for every field of T
+ */
+template <typename T, typename F>
+void ForEachField(F&& f) {
+    for (const FieldDescriptor<T>& field : Fields<T>::list) {
+        f(field);
+    }
+}
+
+/**
+ * Copy every field between two instantiations of the same info struct
+ * (e.g. BiosInfoView -> BiosInfo)
+ */
+template <template <typename> class Info, typename From, typename To>
+void CopyFields(const Info<From>& from, Info<To>& to) {
+    const auto& source = Fields<Info<From>>::list;
+    const auto& target = Fields<Info<To>>::list;
+    for (size_t i = 0; i < sizeof(source) / sizeof(source[0]); i++) {
+        to.*target[i].member = To(from.*source[i].member);
+    }
+}
+
+/**
+ * Call f(name, info...) for every category, in getAllInfo() order (the
+ * category IDs of SerializeSnapshot(), so only append). With several
+ * snapshots f receives the same category of each of them.
+ */
+template <typename F, typename... S>
+void ForEachCategory(F&& f, S&... snapshots) {
+    f("bios", snapshots.bios...);
+    f("system", snapshots.system...);
+    f("board", snapshots.board...);
+    f("processor", snapshots.processor...);
+    f("memory", snapshots.memory...);
+    f("chassis", snapshots.chassis...);
+}
+
+} // namespace smbios
+
+#endif // SMBIOS_FIELDS_H
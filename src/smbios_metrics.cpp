@@ -0,0 +1,224 @@
+#include "smbios_common.h"
+#include "smbios_fields.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace smbios {
+
+namespace {
+
+const char BYTES_METRICS[] =
+    "# TYPE smbios_memory_bytes gauge\n"
+    "# UNIT smbios_memory_bytes bytes\n"
+    "# HELP smbios_memory_bytes Memory counters by kind.\n";
+
+/**
+ * Sample prefix of each MemoryStat, label included
+ */
+const char* const MEMORY_SAMPLES[MEMORY_STAT_COUNT] = {
+    "smbios_memory_bytes{kind=\"total\"} ",
+    "smbios_memory_bytes{kind=\"free\"} ",
+    "smbios_memory_bytes{kind=\"available\"} ",
+    "smbios_memory_bytes{kind=\"buffers\"} ",
+    "smbios_memory_bytes{kind=\"cached\"} ",
+    "smbios_memory_bytes{kind=\"swap_total\"} ",
+    "smbios_memory_bytes{kind=\"swap_free\"} ",
+};
+
+/**
+ * camelCase field name as a snake_case label name
+ */
+void AppendLabelName(std::string& out, const char* name) {
+    for (; *name; name++) {
+        if (std::isupper(static_cast<unsigned char>(*name))) {
+            out += '_';
+            out += static_cast<char>(std::tolower(static_cast<unsigned char>(*name)));
+        } else {
+            out += *name;
+        }
+    }
+}
+
+void AppendLabelValue(std::string& out, std::string_view value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out += c;
+        }
+    }
+}
+
+void AppendSample(std::string& out, const std::string& prefix, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.17g\n", value);
+    out += prefix;
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+/**
+ * Keeps the rendered inventory and per-CPU/per-sensor sample prefixes so
+ * a scrape only formats numbers
+ */
+class MetricsRenderer {
+public:
+    void Render(std::string& out) {
+        if (inventory.empty()) {
+            RenderInventory();
+        }
+        out.assign(inventory);
+
+        double stats[MEMORY_STAT_COUNT];
+        SampleMemoryStats(stats);
+        out += BYTES_METRICS;
+        for (int stat = 0; stat < MEMORY_STAT_COUNT; stat++) {
+            if (!std::isnan(stats[stat])) {
+                AppendSample(out, MEMORY_SAMPLES[stat], stats[stat]);
+            }
+        }
+
+        double systemLoad = SampleCpuLoads(loadState, load);
+        SampleCpuFrequencies(mhz);
+        size_t count = std::max(mhz.size(), load.size());
+        while (cpuPrefixes.size() < count) {
+            std::string cpu = std::to_string(cpuPrefixes.size());
+            cpuPrefixes.push_back({
+                "smbios_cpu_frequency_hertz{cpu=\"" + cpu + "\"} ",
+                "smbios_cpu_load_ratio{cpu=\"" + cpu + "\"} ",
+            });
+        }
+
+        out += "# TYPE smbios_cpu_frequency_hertz gauge\n"
+               "# UNIT smbios_cpu_frequency_hertz hertz\n"
+               "# HELP smbios_cpu_frequency_hertz Current frequency of each CPU.\n";
+        for (size_t cpu = 0; cpu < mhz.size(); cpu++) {
+            if (!std::isnan(mhz[cpu])) {
+                AppendSample(out, cpuPrefixes[cpu].frequency, mhz[cpu] * 1e6);
+            }
+        }
+
+        out += "# TYPE smbios_cpu_load_ratio gauge\n"
+               "# UNIT smbios_cpu_load_ratio ratio\n"
+               "# HELP smbios_cpu_load_ratio Busy fraction of each CPU since the previous scrape.\n";
+        for (size_t cpu = 0; cpu < load.size(); cpu++) {
+            if (!std::isnan(load[cpu])) {
+                AppendSample(out, cpuPrefixes[cpu].load, load[cpu]);
+            }
+        }
+
+        out += "# TYPE smbios_system_load_ratio gauge\n"
+               "# UNIT smbios_system_load_ratio ratio\n"
+               "# HELP smbios_system_load_ratio Busy fraction of the system since the previous scrape.\n";
+        if (!std::isnan(systemLoad)) {
+            AppendSample(out, "smbios_system_load_ratio ", systemLoad);
+        }
+
+        ThermalState thermalState = SampleTemperatures(celsius);
+        if (temperaturePrefixes.empty() && !celsius.empty()) {
+            for (const ThermalSensor& sensor : GetThermalSensors()) {
+                std::string prefix = "smbios_temperature_celsius{chip=\"";
+                AppendLabelValue(prefix, sensor.name);
+                prefix += "\",sensor=\"";
+                AppendLabelValue(prefix, sensor.label);
+                prefix += "\",kind=\"" + sensor.kind + "\"} ";
+                temperaturePrefixes.push_back(std::move(prefix));
+            }
+        }
+
+        out += "# TYPE smbios_temperature_celsius gauge\n"
+               "# UNIT smbios_temperature_celsius celsius\n"
+               "# HELP smbios_temperature_celsius Temperature of each sensor.\n";
+        for (size_t i = 0; i < celsius.size() && i < temperaturePrefixes.size(); i++) {
+            if (!std::isnan(celsius[i])) {
+                AppendSample(out, temperaturePrefixes[i], celsius[i]);
+            }
+        }
+
+        out += "# TYPE smbios_thermal_state stateset\n"
+               "# HELP smbios_thermal_state Worst sensor state against its trip points.\n";
+        if (thermalState != THERMAL_STATE_UNKNOWN) {
+            for (ThermalState state : { THERMAL_STATE_SAFE, THERMAL_STATE_WARNING, THERMAL_STATE_CRITICAL }) {
+                out += "smbios_thermal_state{smbios_thermal_state=\"";
+                out += ThermalStateName(state);
+                out += state == thermalState ? "\"} 1\n" : "\"} 0\n";
+            }
+        }
+
+        out += "# EOF\n";
+    }
+
+private:
+    struct CpuPrefixes {
+        std::string frequency;
+        std::string load;
+    };
+
+    /**
+     * One info metric per static category, non-empty fields as labels.
+     * FIELD_PRIVATE fields (serial numbers, UUID) are never published to
+     * scrapers, as they are kept out of the shared snapshot.
+     */
+    void RenderInventory() {
+        Snapshot snapshot = GetSnapshot(CATEGORY_BIOS | CATEGORY_SYSTEM | CATEGORY_BOARD | CATEGORY_CHASSIS);
+        ForEachCategory([&](const char* category, const auto& info) {
+            using Info = std::decay_t<decltype(info)>;
+            if (std::strcmp(category, "processor") == 0 || std::strcmp(category, "memory") == 0) {
+                return;
+            }
+
+            std::string family = std::string("smbios_") + category;
+            inventory += "# TYPE " + family + " info\n";
+            inventory += "# HELP " + family + " SMBIOS " + category + " information.\n";
+            inventory += family + "_info";
+            bool first = true;
+            ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+                // Sampled with the gauges instead, so the labels stay fixed
+                if (std::strcmp(field.name, "thermalState") == 0) {
+                    return;
+                }
+                if (field.flags & FIELD_PRIVATE) {
+                    return;
+                }
+                const std::string& value = info.*field.member;
+                if (value.empty()) {
+                    return;
+                }
+                inventory += first ? '{' : ',';
+                first = false;
+                AppendLabelName(inventory, field.name);
+                inventory += "=\"";
+                AppendLabelValue(inventory, value);
+                inventory += '"';
+            });
+            inventory += first ? " 1\n" : "} 1\n";
+        }, snapshot);
+    }
+
+    std::string inventory;
+    std::vector<double> mhz;
+    CpuLoadState loadState;         // Separate from fillCpuStats() callers
+    std::vector<double> load;
+    std::vector<double> celsius;
+    std::vector<CpuPrefixes> cpuPrefixes;
+    std::vector<std::string> temperaturePrefixes;
+};
+
+std::mutex metricsMutex;
+
+} // namespace
+
+void RenderOpenMetrics(std::string& out) {
+    static MetricsRenderer renderer;
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    renderer.Render(out);
+}
+
+} // namespace smbios
@@ -0,0 +1,128 @@
+#ifndef SMBIOS_PERFECT_HASH_H
+#define SMBIOS_PERFECT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace smbios {
+
+namespace perfect_hash {
+
+constexpr bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+constexpr char Lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * Walks a string in normalized form (lowercase, trimmed, inner whitespace
+ * collapsed to a single space) without copying it
+ */
+class Normalized {
+public:
+    constexpr explicit Normalized(std::string_view str) : text(str), pos(0), end(str.size()) {
+        while (pos < end && IsSpace(text[pos])) pos++;
+        while (end > pos && IsSpace(text[end - 1])) end--;
+    }
+
+    constexpr bool Next(char& c) {
+        if (pos >= end) {
+            return false;
+        }
+        if (IsSpace(text[pos])) {
+            while (IsSpace(text[pos])) pos++;
+            c = ' ';
+        } else {
+            c = Lower(text[pos++]);
+        }
+        return true;
+    }
+
+private:
+    std::string_view text;
+    size_t pos;
+    size_t end;
+};
+
+constexpr uint32_t Hash(std::string_view str, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    Normalized normalized(str);
+    char c = 0;
+    while (normalized.Next(c)) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x7feb352du;
+    hash ^= hash >> 15;
+    return hash;
+}
+
+/**
+ * True if str, normalized, equals key (which must already be normalized)
+ */
+constexpr bool Equals(std::string_view str, std::string_view key) {
+    Normalized normalized(str);
+    size_t i = 0;
+    char c = 0;
+    while (normalized.Next(c)) {
+        if (i >= key.size() || key[i] != c) {
+            return false;
+        }
+        i++;
+    }
+    return i == key.size();
+}
+
+const uint8_t EMPTY_SLOT = 0xFF;
+
+/**
+ * Perfect hash over a fixed key list: a seed under which every key lands
+ * in its own slot, searched for at compile time. Lookups are one hash and
+ * one compare; matching is case- and whitespace-insensitive.
+ */
+template <size_t SlotCount>
+struct Table {
+    static_assert((SlotCount & (SlotCount - 1)) == 0, "SlotCount must be a power of two");
+
+    bool valid;
+    uint32_t seed;
+    uint8_t slots[SlotCount];
+
+    /**
+     * Index of the key equal to value, or -1
+     */
+    constexpr int Find(std::string_view value, const std::string_view* keys) const {
+        uint8_t index = slots[Hash(value, seed) & (SlotCount - 1)];
+        return index != EMPTY_SLOT && Equals(value, keys[index]) ? index : -1;
+    }
+};
+
+template <size_t SlotCount>
+constexpr Table<SlotCount> Build(const std::string_view* keys, size_t count) {
+    for (uint32_t seed = 0; seed < 1024 && count < EMPTY_SLOT; seed++) {
+        Table<SlotCount> table = { true, seed, {} };
+        for (size_t i = 0; i < SlotCount; i++) {
+            table.slots[i] = EMPTY_SLOT;
+        }
+        for (size_t i = 0; i < count && table.valid; i++) {
+            size_t slot = Hash(keys[i], seed) & (SlotCount - 1);
+            if (table.slots[slot] != EMPTY_SLOT || !Equals(keys[i], keys[i])) {
+                table.valid = false;
+            }
+            table.slots[slot] = static_cast<uint8_t>(i);
+        }
+        if (table.valid) {
+            return table;
+        }
+    }
+    return Table<SlotCount>{ false, 0, {} };
+}
+
+} // namespace perfect_hash
+
+} // namespace smbios
+
+#endif // SMBIOS_PERFECT_HASH_H
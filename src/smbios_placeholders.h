@@ -0,0 +1,99 @@
+#ifndef SMBIOS_PLACEHOLDERS_H
+#define SMBIOS_PLACEHOLDERS_H
+
+#include "smbios_fields.h"
+#include "smbios_perfect_hash.h"
+#include <string_view>
+
+namespace smbios {
+
+namespace placeholders {
+
+/**
+ * Values firmware vendors leave in unprogrammed SMBIOS/DMI strings, in
+ * normalized form (lowercase, trimmed, inner whitespace collapsed to a
+ * single space). Matching is case- and whitespace-insensitive. Only
+ * unambiguous placeholders belong here: generic words such as "0",
+ * "none" or "unknown" are legitimate values of enumerations and counters
+ * (see ZERO_FIELDS).
+ */
+constexpr std::string_view KNOWN[] = {
+    "to be filled by o.e.m.", "to be filled by o.e.m", "to be filled by oem",
+    "filled by o.e.m.", "o.e.m.", "oem_serial",
+    "default string", "not specified", "not applicable",
+    "not available", "not defined", "undefined", "invalid",
+    "00000000", "0000000000", "123456789", "1234567890", "0123456789",
+    "system serial number", "system product name", "system manufacturer",
+    "system version", "system sku", "system sku#", "system name",
+    "serial number", "serialnumber", "product name",
+    "board serial number", "base board serial number", "board version",
+    "asset tag", "no asset tag", "no asset information", "asset-1234567890",
+    "chassis serial number", "chassis manufacture", "chassis manufacturer",
+    "chassis version",
+    "type1productconfigid", "type1sku0", "type1family",
+    "type2 - board serial number", "type2 - board asset tag",
+    "type2 - board vendor name1", "type2 - board product name1",
+    "type2 - board version",
+    "00000000-0000-0000-0000-000000000000",
+    "ffffffff-ffff-ffff-ffff-ffffffffffff",
+    "03000200-0400-0500-0006-000700080009",
+};
+constexpr size_t KNOWN_COUNT = sizeof(KNOWN) / sizeof(KNOWN[0]);
+
+inline constexpr perfect_hash::Table<1024> TABLE = perfect_hash::Build<1024>(KNOWN, KNOWN_COUNT);
+static_assert(TABLE.valid, "No perfect hash seed found for the placeholder set (or a key is not normalized)");
+
+/**
+ * Fields where "0" is also unprogrammed; elsewhere (e.g. a board
+ * version) it is a real value, so it is not in KNOWN
+ */
+constexpr std::string_view ZERO_FIELDS[] = { "serialNumber", "assetTag" };
+
+} // namespace placeholders
+
+/**
+ * True if value is a known OEM placeholder: one hash and one compare
+ */
+constexpr bool IsPlaceholder(std::string_view value) {
+    return !value.empty() && placeholders::TABLE.Find(value, placeholders::KNOWN) >= 0;
+}
+
+/**
+ * True if value is a placeholder for the identity field named `field`
+ */
+constexpr bool IsIdentityPlaceholder(std::string_view field, std::string_view value) {
+    if (IsPlaceholder(value)) {
+        return true;
+    }
+    if (!perfect_hash::Equals(value, "0")) {
+        return false;
+    }
+    for (std::string_view name : placeholders::ZERO_FIELDS) {
+        if (field == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static_assert(IsIdentityPlaceholder("serialNumber", "0") && IsIdentityPlaceholder("assetTag", " 0 "),
+              "An unprogrammed serial number or asset tag of \"0\" must be cleared");
+static_assert(!IsIdentityPlaceholder("version", "0") && !IsIdentityPlaceholder("serialNumber", "00"),
+              "\"0\" is only a placeholder for serial numbers and asset tags");
+
+/**
+ * Clear the FIELD_IDENTITY fields of an info struct that hold a
+ * placeholder; enumerations, counters and sizes are left alone
+ */
+template <typename T>
+void NormalizeInfo(T& info) {
+    ForEachField<T>([&](const FieldDescriptor<T>& field) {
+        if ((field.flags & FIELD_IDENTITY) && IsIdentityPlaceholder(field.name, info.*field.member)) {
+            info.*field.member = typename T::string_type();
+        }
+    });
+}
+
+} // namespace smbios
+
+#endif // SMBIOS_PLACEHOLDERS_H
@@ -0,0 +1,449 @@
+#include "smbios_common.h"
+#include "smbios_table.h"
+#include <cstdio>
+
+namespace smbios {
+
+namespace {
+
+const uint8_t TYPE_CHASSIS = 3;
+const uint8_t TYPE_PROCESSOR = 4;
+const uint8_t TYPE_CACHE = 7;
+const uint8_t TYPE_SYSTEM_SLOT = 9;
+const uint8_t TYPE_ONBOARD_DEVICE = 41;
+
+/**
+ * Format a PCI address as "ssss:bb:dd.f", or "" if the firmware left
+ * it unset (segment 0xFFFF, bus 0xFF, device/function 0xFF)
+ */
+std::string FormatPciAddress(uint16_t segment, uint8_t bus, uint8_t devfn) {
+    if (segment == 0xFFFF && bus == 0xFF && devfn == 0xFF) {
+        return "";
+    }
+
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%04x:%02x:%02x.%x",
+             segment, bus, devfn >> 3, devfn & 0x07);
+    return buffer;
+}
+
+/**
+ * Boot-up, power supply and thermal state codes of the Chassis structure
+ */
+std::string ChassisStateName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Safe", "Warning", "Critical", "Non-recoverable"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+std::string ProcessorTypeName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Central Processor", "Math Processor",
+        "DSP Processor", "Video Processor"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+/**
+ * Processor family names for the codes seen on current hardware.
+ * Unlisted codes are reported numerically.
+ */
+std::string ProcessorFamilyName(uint16_t code) {
+    struct Family {
+        uint16_t code;
+        const char* name;
+    };
+    static const Family families[] = {
+        { 0x01, "Other" }, { 0x02, "Unknown" },
+        { 0x0B, "Pentium" }, { 0x0C, "Pentium Pro" }, { 0x0D, "Pentium II" },
+        { 0x0F, "Celeron" }, { 0x10, "Pentium II Xeon" }, { 0x11, "Pentium III" },
+        { 0x28, "Core Duo" }, { 0x29, "Core Duo Mobile" }, { 0x2A, "Core Solo Mobile" },
+        { 0x2B, "Atom" }, { 0x2C, "Core M" }, { 0x2D, "Core m3" }, { 0x2E, "Core m5" },
+        { 0x2F, "Core m7" },
+        { 0x66, "Athlon X4" }, { 0x67, "Opteron X1000" }, { 0x68, "Opteron X2000 APU" },
+        { 0x69, "Opteron A-Series" }, { 0x6A, "Opteron X3000 APU" }, { 0x6B, "Zen" },
+        { 0x83, "Athlon 64" }, { 0x84, "Opteron" }, { 0x85, "Sempron" },
+        { 0x86, "Turion 64" }, { 0x87, "Dual-Core Opteron" }, { 0x88, "Athlon 64 X2" },
+        { 0x89, "Turion 64 X2" }, { 0x8A, "Quad-Core Opteron" },
+        { 0x8B, "Third-Generation Opteron" }, { 0x8C, "Phenom FX" },
+        { 0x8D, "Phenom X4" }, { 0x8E, "Phenom X2" }, { 0x8F, "Athlon X2" },
+        { 0xB0, "Pentium III Xeon" }, { 0xB1, "Pentium III Speedstep" },
+        { 0xB2, "Pentium 4" }, { 0xB3, "Xeon" }, { 0xB5, "Xeon MP" },
+        { 0xB6, "Athlon XP" }, { 0xB7, "Athlon MP" }, { 0xB8, "Itanium 2" },
+        { 0xB9, "Pentium M" }, { 0xBA, "Celeron D" }, { 0xBB, "Pentium D" },
+        { 0xBC, "Pentium EE" }, { 0xBD, "Core Solo" }, { 0xBF, "Core 2 Duo" },
+        { 0xC0, "Core 2 Solo" }, { 0xC1, "Core 2 Extreme" }, { 0xC2, "Core 2 Quad" },
+        { 0xC3, "Core 2 Extreme Mobile" }, { 0xC4, "Core 2 Duo Mobile" },
+        { 0xC5, "Core 2 Solo Mobile" }, { 0xC6, "Core i7" }, { 0xC7, "Dual-Core Celeron" },
+        { 0xCD, "Core i5" }, { 0xCE, "Core i3" }, { 0xCF, "Core i9" },
+        { 0xD6, "Multi-Core Xeon" }, { 0xD7, "Dual-Core Xeon 3xxx" },
+        { 0xD8, "Quad-Core Xeon 3xxx" }, { 0xDA, "Dual-Core Xeon 5xxx" },
+        { 0xDB, "Quad-Core Xeon 5xxx" }, { 0xDD, "Dual-Core Xeon 7xxx" },
+        { 0xDE, "Quad-Core Xeon 7xxx" }, { 0xDF, "Multi-Core Xeon 7xxx" },
+        { 0xE0, "Multi-Core Xeon 3400" },
+        { 0xE4, "Opteron 3000" }, { 0xE5, "Sempron II" },
+        { 0xE6, "Embedded Opteron Quad-Core" }, { 0xE7, "Phenom Triple-Core" },
+        { 0xE8, "Turion Ultra Dual-Core Mobile" }, { 0xE9, "Turion Dual-Core Mobile" },
+        { 0xEA, "Athlon Dual-Core" }, { 0xEB, "Sempron SI" },
+        { 0xEC, "Phenom II" }, { 0xED, "Athlon II" }, { 0xEE, "Six-Core Opteron" },
+        { 0xEF, "Sempron M" },
+        { 0x100, "ARMv7" }, { 0x101, "ARMv8" }, { 0x102, "ARMv9" },
+        { 0x118, "ARM" }, { 0x119, "StrongARM" },
+        { 0x200, "RISC-V RV32" }, { 0x201, "RISC-V RV64" }, { 0x202, "RISC-V RV128" },
+        { 0x258, "LoongArch" }
+    };
+
+    for (const Family& family : families) {
+        if (family.code == code) {
+            return family.name;
+        }
+    }
+    return code ? std::to_string(code) : "";
+}
+
+std::string ProcessorStatusName(uint8_t status) {
+    switch (status & 0x07) {
+        case 1: return "Enabled";
+        case 2: return "Disabled By User";
+        case 3: return "Disabled By BIOS";
+        case 4: return "Idle";
+        case 7: return "Other";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * Processor voltage: bit 7 selects the current value in tenths of a volt,
+ * otherwise bits 0-2 flag the legacy 5V/3.3V/2.9V capabilities
+ */
+double ProcessorVoltage(uint8_t code) {
+    if (code & 0x80) {
+        return (code & 0x7F) / 10.0;
+    }
+    if (code & 0x01) return 5.0;
+    if (code & 0x02) return 3.3;
+    if (code & 0x04) return 2.9;
+    return 0;
+}
+
+std::string CacheTypeName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Instruction", "Data", "Unified"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+std::string CacheAssociativityName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Direct Mapped", "2-way Set-Associative",
+        "4-way Set-Associative", "Fully Associative", "8-way Set-Associative",
+        "16-way Set-Associative", "12-way Set-Associative",
+        "24-way Set-Associative", "32-way Set-Associative",
+        "48-way Set-Associative", "64-way Set-Associative",
+        "20-way Set-Associative"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+std::string CacheErrorCorrectionName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "None", "Parity", "Single-bit ECC", "Multi-bit ECC"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+/**
+ * Cache sizes: bit 15 (bit 31 for the 3.1+ 32-bit fields) selects
+ * 64K granularity instead of 1K
+ */
+uint64_t CacheSize(uint16_t size, uint32_t size2) {
+    if (size == 0xFFFF && size2 != 0) {
+        uint64_t granularity = (size2 & 0x80000000u) ? 64 * 1024 : 1024;
+        return (size2 & 0x7FFFFFFFu) * granularity;
+    }
+    uint64_t granularity = (size & 0x8000) ? 64 * 1024 : 1024;
+    return (size & 0x7FFF) * granularity;
+}
+
+CacheInfo DecodeCache(const Table& table, const Structure& s) {
+    static const char* const locations[] = { "Internal", "External", "Reserved", "Unknown" };
+    static const char* const modes[] = { "Write Through", "Write Back", "Varies With Memory Address", "Unknown" };
+
+    uint16_t config = table.Word(s, 0x05);
+
+    CacheInfo cache;
+    cache.socketDesignation = table.Text(s, 0x04);
+    cache.level = static_cast<uint8_t>((config & 0x07) + 1);
+    cache.enabled = (config & 0x80) != 0;
+    cache.location = locations[(config >> 5) & 0x03];
+    cache.operationalMode = modes[(config >> 8) & 0x03];
+    cache.cacheType = CacheTypeName(table.Byte(s, 0x11));
+    cache.associativity = CacheAssociativityName(table.Byte(s, 0x12));
+    cache.errorCorrection = CacheErrorCorrectionName(table.Byte(s, 0x10));
+    cache.maximumSize = CacheSize(table.Word(s, 0x07), table.DWord(s, 0x13));
+    cache.installedSize = CacheSize(table.Word(s, 0x09), table.DWord(s, 0x17));
+    return cache;
+}
+
+std::string SlotTypeName(uint8_t code) {
+    static const char* const base[] = {
+        "Other", "Unknown", "ISA", "MCA", "EISA", "PCI", "PC Card (PCMCIA)",
+        "VLB", "Proprietary", "Processor Card", "Proprietary Memory Card",
+        "I/O Riser Card", "NuBus", "PCI-66", "AGP", "AGP 2x", "AGP 4x",
+        "PCI-X", "AGP 8x", "M.2 Socket 1-DP", "M.2 Socket 1-SD", "M.2 Socket 2",
+        "M.2 Socket 3", "MXM Type I", "MXM Type II", "MXM Type III",
+        "MXM Type III-HE", "MXM Type IV", "MXM 3.0 Type A", "MXM 3.0 Type B",
+        "PCI Express Gen 2 SFF-8639 (U.2)", "PCI Express Gen 3 SFF-8639 (U.2)",
+        "PCI Express Mini 52-pin with bottom-side keep-outs",
+        "PCI Express Mini 52-pin without bottom-side keep-outs",
+        "PCI Express Mini 76-pin", "PCI Express Gen 4 SFF-8639 (U.2)",
+        "PCI Express Gen 5 SFF-8639 (U.2)", "OCP NIC 3.0 Small Form Factor (SFF)",
+        "OCP NIC 3.0 Large Form Factor (LFF)", "OCP NIC Prior to 3.0"
+    };
+    static const char* const pc98[] = {
+        "PC-98/C20", "PC-98/C24", "PC-98/E", "PC-98/Local Bus", "PC-98/Card"
+    };
+    // 0xA5-0xC6: PCI Express generations, each as base, x1, x2, x4, x8, x16
+    // (0xB7 is reserved)
+    static const char* const pcie[] = {
+        "PCI Express", "PCI Express x1", "PCI Express x2", "PCI Express x4",
+        "PCI Express x8", "PCI Express x16",
+        "PCI Express Gen 2", "PCI Express Gen 2 x1", "PCI Express Gen 2 x2",
+        "PCI Express Gen 2 x4", "PCI Express Gen 2 x8", "PCI Express Gen 2 x16",
+        "PCI Express Gen 3", "PCI Express Gen 3 x1", "PCI Express Gen 3 x2",
+        "PCI Express Gen 3 x4", "PCI Express Gen 3 x8", "PCI Express Gen 3 x16",
+        nullptr,
+        "PCI Express Gen 4", "PCI Express Gen 4 x1", "PCI Express Gen 4 x2",
+        "PCI Express Gen 4 x4", "PCI Express Gen 4 x8", "PCI Express Gen 4 x16",
+        "PCI Express Gen 5", "PCI Express Gen 5 x1", "PCI Express Gen 5 x2",
+        "PCI Express Gen 5 x4", "PCI Express Gen 5 x8", "PCI Express Gen 5 x16",
+        "PCI Express Gen 6 and Beyond", "EDSFF E1", "EDSFF E3"
+    };
+
+    if (code >= 0x01 && code < 0x01 + sizeof(base) / sizeof(base[0])) {
+        return base[code - 0x01];
+    }
+    if (code == 0x30) {
+        return "CXL Flexbus 1.0";
+    }
+    if (code >= 0xA0 && code < 0xA0 + sizeof(pc98) / sizeof(pc98[0])) {
+        return pc98[code - 0xA0];
+    }
+    if (code >= 0xA5 && code < 0xA5 + sizeof(pcie) / sizeof(pcie[0]) && pcie[code - 0xA5]) {
+        return pcie[code - 0xA5];
+    }
+    return code ? "Unknown (" + std::to_string(code) + ")" : "";
+}
+
+std::string SlotWidthName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "8 bit", "16 bit", "32 bit", "64 bit", "128 bit",
+        "x1", "x2", "x4", "x8", "x12", "x16", "x32"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+std::string SlotUsageName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Available", "In Use", "Unavailable"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+std::string SlotLengthName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Short", "Long", "2.5\" Drive Form Factor",
+        "3.5\" Drive Form Factor"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+std::string OnboardDeviceTypeName(uint8_t code) {
+    static const char* const names[] = {
+        "Other", "Unknown", "Video", "SCSI Controller", "Ethernet",
+        "Token Ring", "Sound", "PATA Controller", "SATA Controller",
+        "SAS Controller", "Wireless LAN", "Bluetooth", "WWAN", "eMMC",
+        "NVMe Controller", "UFS Controller"
+    };
+    if (code >= 0x01 && code < 0x01 + sizeof(names) / sizeof(names[0])) {
+        return names[code - 0x01];
+    }
+    return "";
+}
+
+} // namespace
+
+std::vector<ProcessorSocket> GetProcessorSockets() {
+    std::vector<ProcessorSocket> sockets;
+    const Table& table = GetTable();
+
+    for (const Structure* s = table.TypeBegin(TYPE_PROCESSOR); s != table.TypeEnd(TYPE_PROCESSOR); ++s) {
+        ProcessorSocket proc;
+        proc.socketDesignation = table.Text(*s, 0x04);
+        proc.processorType = ProcessorTypeName(table.Byte(*s, 0x05));
+        proc.manufacturer = table.Text(*s, 0x07);
+        proc.version = table.Text(*s, 0x10);
+        proc.voltage = ProcessorVoltage(table.Byte(*s, 0x11));
+        proc.externalClock = table.Word(*s, 0x12);
+        proc.maxSpeed = table.Word(*s, 0x14);
+        proc.currentSpeed = table.Word(*s, 0x16);
+
+        // 0xFE defers to the 16-bit Processor Family 2 field (SMBIOS 2.6+)
+        uint16_t family = table.Byte(*s, 0x06);
+        if (family == 0xFE && table.Has(*s, 0x28, 2)) {
+            family = table.Word(*s, 0x28);
+        }
+        proc.processorFamily = ProcessorFamilyName(family);
+
+        char id[17];
+        snprintf(id, sizeof(id), "%016llx", static_cast<unsigned long long>(table.QWord(*s, 0x08)));
+        proc.processorId = id;
+
+        uint8_t status = table.Byte(*s, 0x18);
+        proc.populated = (status & 0x40) != 0;
+        proc.status = ProcessorStatusName(status);
+
+        proc.serialNumber = table.Text(*s, 0x20);
+        proc.assetTag = table.Text(*s, 0x21);
+        proc.partNumber = table.Text(*s, 0x22);
+
+        // Counts saturate at 0xFF; the 16-bit "2" fields (SMBIOS 3.0+) hold the real value
+        proc.coreCount = table.Byte(*s, 0x23);
+        proc.coreEnabled = table.Byte(*s, 0x24);
+        proc.threadCount = table.Byte(*s, 0x25);
+        if (proc.coreCount == 0xFF && table.Has(*s, 0x2A, 2)) proc.coreCount = table.Word(*s, 0x2A);
+        if (proc.coreEnabled == 0xFF && table.Has(*s, 0x2C, 2)) proc.coreEnabled = table.Word(*s, 0x2C);
+        if (proc.threadCount == 0xFF && table.Has(*s, 0x2E, 2)) proc.threadCount = table.Word(*s, 0x2E);
+        proc.threadEnabled = table.Has(*s, 0x30, 2) ? table.Word(*s, 0x30) : proc.threadCount;
+
+        // L1/L2/L3 cache handles (SMBIOS 2.1+), 0xFFFF when not provided
+        for (size_t off = 0x1A; off <= 0x1E; off += 2) {
+            if (!table.Has(*s, off, 2)) {
+                break;
+            }
+            uint16_t handle = table.Word(*s, off);
+            const Structure* cache = handle != 0xFFFF ? table.FindByHandle(handle) : nullptr;
+            if (cache && cache->type == TYPE_CACHE) {
+                proc.caches.push_back(DecodeCache(table, *cache));
+            }
+        }
+
+        sockets.push_back(proc);
+    }
+
+    return sockets;
+}
+
+std::vector<SystemSlot> GetSystemSlots() {
+    std::vector<SystemSlot> slots;
+    const Table& table = GetTable();
+
+    for (const Structure* s = table.TypeBegin(TYPE_SYSTEM_SLOT); s != table.TypeEnd(TYPE_SYSTEM_SLOT); ++s) {
+        SystemSlot slot;
+        slot.designation = table.Text(*s, 0x04);
+        slot.slotType = SlotTypeName(table.Byte(*s, 0x05));
+        slot.dataBusWidth = SlotWidthName(table.Byte(*s, 0x06));
+        slot.currentUsage = SlotUsageName(table.Byte(*s, 0x07));
+        slot.slotLength = SlotLengthName(table.Byte(*s, 0x08));
+        slot.slotId = table.Word(*s, 0x09);
+
+        // Segment/bus/device/function (SMBIOS 2.6+)
+        if (table.Has(*s, 0x0D, 4)) {
+            uint8_t devfn = table.Byte(*s, 0x10);
+            slot.segment = table.Word(*s, 0x0D);
+            slot.bus = table.Byte(*s, 0x0F);
+            slot.device = devfn >> 3;
+            slot.function = devfn & 0x07;
+            slot.pciAddress = FormatPciAddress(slot.segment, slot.bus, devfn);
+        }
+
+        // Peer groups (SMBIOS 3.2+): 5 bytes each after the count at 0x12
+        size_t peerCount = table.Byte(*s, 0x12);
+        for (size_t i = 0; i < peerCount && table.Has(*s, 0x13 + i * 5, 5); i++) {
+            size_t off = 0x13 + i * 5;
+            uint8_t devfn = table.Byte(*s, off + 3);
+            SlotPeer peer;
+            peer.segment = table.Word(*s, off);
+            peer.bus = table.Byte(*s, off + 2);
+            peer.device = devfn >> 3;
+            peer.function = devfn & 0x07;
+            peer.dataBusWidth = table.Byte(*s, off + 4);
+            slot.peers.push_back(peer);
+        }
+
+        // Physical width (SMBIOS 3.4+) follows the peer groups
+        size_t physicalWidthOffset = 0x13 + peerCount * 5 + 1;
+        slot.physicalWidth = SlotWidthName(table.Byte(*s, physicalWidthOffset));
+
+        slots.push_back(slot);
+    }
+
+    return slots;
+}
+
+std::vector<OnboardDevice> GetOnboardDevices() {
+    std::vector<OnboardDevice> devices;
+    const Table& table = GetTable();
+
+    for (const Structure* s = table.TypeBegin(TYPE_ONBOARD_DEVICE); s != table.TypeEnd(TYPE_ONBOARD_DEVICE); ++s) {
+        uint8_t type = table.Byte(*s, 0x05);
+        uint8_t devfn = table.Byte(*s, 0x0A);
+
+        OnboardDevice device;
+        device.referenceDesignation = table.Text(*s, 0x04);
+        device.deviceType = OnboardDeviceTypeName(type & 0x7F);
+        device.enabled = (type & 0x80) != 0;
+        device.instance = table.Byte(*s, 0x06);
+        device.segment = table.Word(*s, 0x07);
+        device.bus = table.Byte(*s, 0x09);
+        device.device = devfn >> 3;
+        device.function = devfn & 0x07;
+        device.pciAddress = FormatPciAddress(device.segment, device.bus, devfn);
+
+        devices.push_back(device);
+    }
+
+    return devices;
+}
+
+ChassisStates GetChassisStates() {
+    ChassisStates states;
+    const Table& table = GetTable();
+
+    // The state bytes were added in SMBIOS 2.1; Byte() reads 0 past the
+    // formatted area, which maps to ""
+    if (const Structure* s = table.FindFirst(TYPE_CHASSIS)) {
+        states.bootUp = ChassisStateName(table.Byte(*s, 0x09));
+        states.powerSupply = ChassisStateName(table.Byte(*s, 0x0A));
+        states.thermal = ChassisStateName(table.Byte(*s, 0x0B));
+    }
+
+    return states;
+}
+
+} // namespace smbios
@@ -0,0 +1,209 @@
+#include "smbios_common.h"
+#include "smbios_fields.h"
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace smbios {
+
+namespace {
+
+const uint8_t MAGIC[3] = { 'S', 'M', 'B' };
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * Canonical decimal ("0" or no leading zero, below 10^19) that survives
+ * a round trip through uint64_t
+ */
+bool ParseNumber(std::string_view text, uint64_t& value) {
+    if (text.empty() || text.size() > 19 || (text[0] == '0' && text.size() > 1)) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
+
+/**
+ * Bounds-checked cursor over the encoded bytes
+ */
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : next(data), end(data + size) {}
+
+    bool Varint(uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (next == end) {
+                return false;
+            }
+            uint8_t byte = *next++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Bytes(size_t count, std::string_view& bytes) {
+        if (static_cast<size_t>(end - next) < count) {
+            return false;
+        }
+        bytes = std::string_view(reinterpret_cast<const char*>(next), count);
+        next += count;
+        return true;
+    }
+
+    bool AtEnd() const { return next == end; }
+
+private:
+    const uint8_t* next;
+    const uint8_t* end;
+};
+
+} // namespace
+
+std::vector<uint8_t> SerializeSnapshot(const Snapshot& snapshot) {
+    // Body first, so the string table can precede it with only the
+    // strings actually referenced
+    std::vector<uint8_t> body;
+    std::vector<std::string_view> strings;
+    std::unordered_map<std::string_view, uint64_t> stringIds;
+
+    // Categories in ForEachCategory() order; the position is the category ID
+    size_t categoryCount = 0;
+    ForEachCategory([&](const char*, const auto&) { categoryCount++; }, snapshot);
+    WriteVarint(body, categoryCount);
+    ForEachCategory([&](const char*, const auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        const auto& fields = Fields<Info>::list;
+        const size_t fieldCount = sizeof(fields) / sizeof(fields[0]);
+
+        size_t present = 0;
+        for (size_t i = 0; i < fieldCount; i++) {
+            present += !(info.*fields[i].member).empty();
+        }
+        WriteVarint(body, present);
+
+        for (size_t i = 0; i < fieldCount; i++) {
+            std::string_view value = info.*fields[i].member;
+            if (value.empty()) {
+                continue;
+            }
+            uint64_t number = 0;
+            if (ParseNumber(value, number)) {
+                WriteVarint(body, (i << 1) | 1);
+                WriteVarint(body, number);
+                continue;
+            }
+            auto inserted = stringIds.emplace(value, strings.size());
+            if (inserted.second) {
+                strings.push_back(value);
+            }
+            WriteVarint(body, i << 1);
+            WriteVarint(body, inserted.first->second);
+        }
+    }, snapshot);
+
+    std::vector<uint8_t> out(MAGIC, MAGIC + sizeof(MAGIC));
+    out.push_back(SNAPSHOT_FORMAT_VERSION);
+    WriteVarint(out, strings.size());
+    for (std::string_view text : strings) {
+        WriteVarint(out, text.size());
+        out.insert(out.end(), text.begin(), text.end());
+    }
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+bool DeserializeSnapshot(const uint8_t* data, size_t size, Snapshot& snapshot) {
+    snapshot = Snapshot();
+    if (size < sizeof(MAGIC) + 1 || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        data[sizeof(MAGIC)] != SNAPSHOT_FORMAT_VERSION) {
+        return false;
+    }
+    Reader reader(data + sizeof(MAGIC) + 1, size - sizeof(MAGIC) - 1);
+
+    // Views into `data`; copied into the snapshot as fields reference them
+    uint64_t stringCount = 0;
+    if (!reader.Varint(stringCount) || stringCount > size) {
+        return false;
+    }
+    std::vector<std::string_view> strings(static_cast<size_t>(stringCount));
+    for (std::string_view& text : strings) {
+        uint64_t length = 0;
+        if (!reader.Varint(length) || !reader.Bytes(static_cast<size_t>(length), text)) {
+            return false;
+        }
+    }
+
+    uint64_t categoryCount = 0;
+    if (!reader.Varint(categoryCount)) {
+        return false;
+    }
+
+    // Each entry is one key and one value varint, so IDs this version does
+    // not know (fields or categories appended later) are skipped
+    bool ok = true;
+    auto readCategory = [&](auto* info) {
+        uint64_t entries = 0;
+        if (!reader.Varint(entries)) {
+            return false;
+        }
+        for (uint64_t e = 0; e < entries; e++) {
+            uint64_t key = 0;
+            uint64_t value = 0;
+            if (!reader.Varint(key) || !reader.Varint(value)) {
+                return false;
+            }
+            if (!(key & 1) && value >= strings.size()) {
+                return false;
+            }
+            if (!info) {
+                continue;
+            }
+
+            using Info = std::remove_pointer_t<decltype(info)>;
+            const auto& fields = Fields<Info>::list;
+            uint64_t field = key >> 1;
+            if (field < sizeof(fields) / sizeof(fields[0])) {
+                std::string& target = info->*fields[field].member;
+                if (key & 1) {
+                    target = std::to_string(value);
+                } else {
+                    target = std::string(strings[static_cast<size_t>(value)]);
+                }
+            }
+        }
+        return true;
+    };
+
+    uint64_t category = 0;
+    ForEachCategory([&](const char*, auto& info) {
+        if (ok && category < categoryCount) {
+            ok = readCategory(&info);
+            category++;
+        }
+    }, snapshot);
+    for (; ok && category < categoryCount; category++) {
+        ok = readCategory(static_cast<BiosInfo*>(nullptr));
+    }
+
+    return ok && reader.AtEnd();
+}
+
+} // namespace smbios
@@ -0,0 +1,353 @@
+#include "smbios_common.h"
+#include "smbios_fields.h"
+#include "smbios_placeholders.h"
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace smbios {
+
+namespace {
+
+/**
+ * Shared snapshot file layout (version 2, host byte order):
+ *
+ *   Header
+ *   Entry[fieldCount]      offset/length of each field in the string pool,
+ *                          in descriptor order (all categories)
+ *   char pool[poolSize]
+ *
+ * The schema hash covers the category and field names, so processes
+ * built from different versions of this module never misread each
+ * other's files; they simply rebuild it.
+ *
+ * The file is world-readable, so FIELD_PRIVATE fields are stored empty;
+ * every reader fills them in with its own privileges.
+ */
+const char SNAPSHOT_MAGIC[8] = { 'S', 'M', 'B', 'I', 'O', 'S', 'S', 'N' };
+const uint32_t SNAPSHOT_VERSION = 2;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t schemaHash;
+    uint32_t fieldCount;
+    uint32_t poolSize;
+    char bootId[40];
+};
+
+struct Entry {
+    uint32_t offset;
+    uint32_t length;
+};
+
+uint32_t SchemaHash() {
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const char* text) {
+        for (; *text; text++) {
+            hash = (hash ^ static_cast<uint8_t>(*text)) * 16777619u;
+        }
+        hash = (hash ^ '\n') * 16777619u;
+    };
+
+    Snapshot snapshot;
+    ForEachCategory([&](const char* category, auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        mix(category);
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) { mix(field.name); });
+    }, snapshot);
+    return hash;
+}
+
+std::vector<uint8_t> EncodeShared(const Snapshot& snapshot, const std::string& bootId) {
+    std::vector<Entry> entries;
+    std::string pool;
+    ForEachCategory([&](const char*, const auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+            std::string_view value = (field.flags & FIELD_PRIVATE) ? std::string_view() : info.*field.member;
+            entries.push_back({ static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(value.size()) });
+            pool += value;
+        });
+    }, snapshot);
+
+    Header header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.schemaHash = SchemaHash();
+    header.fieldCount = static_cast<uint32_t>(entries.size());
+    header.poolSize = static_cast<uint32_t>(pool.size());
+    std::strncpy(header.bootId, bootId.c_str(), sizeof(header.bootId) - 1);
+
+    std::vector<uint8_t> data(sizeof(Header) + entries.size() * sizeof(Entry) + pool.size());
+    std::memcpy(data.data(), &header, sizeof(Header));
+    std::memcpy(data.data() + sizeof(Header), entries.data(), entries.size() * sizeof(Entry));
+    std::memcpy(data.data() + sizeof(Header) + entries.size() * sizeof(Entry), pool.data(), pool.size());
+    return data;
+}
+
+/**
+ * Point the views of `snapshot` into the mapped file; no strings are copied
+ */
+bool DecodeShared(const uint8_t* data, size_t size, const std::string& bootId, SnapshotView& snapshot) {
+    if (size < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    header.bootId[sizeof(header.bootId) - 1] = '\0';
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SNAPSHOT_VERSION ||
+        header.schemaHash != SchemaHash() ||
+        bootId != header.bootId) {
+        return false;
+    }
+
+    size_t entriesSize = static_cast<size_t>(header.fieldCount) * sizeof(Entry);
+    if (size != sizeof(Header) + entriesSize + header.poolSize) {
+        return false;
+    }
+
+    const uint8_t* entries = data + sizeof(Header);
+    const char* pool = reinterpret_cast<const char*>(entries + entriesSize);
+    uint32_t index = 0;
+    bool valid = true;
+    ForEachCategory([&](const char*, auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+            Entry entry;
+            if (!valid || index >= header.fieldCount) {
+                valid = false;
+                return;
+            }
+            std::memcpy(&entry, entries + index++ * sizeof(Entry), sizeof(Entry));
+            if (static_cast<uint64_t>(entry.offset) + entry.length > header.poolSize) {
+                valid = false;
+                return;
+            }
+            info.*field.member = std::string_view(pool + entry.offset, entry.length);
+        });
+    }, snapshot);
+
+    return valid && index == header.fieldCount;
+}
+
+#ifndef _WIN32
+
+/**
+ * Read-only mapping of a shared snapshot file and the views into it. The
+ * private fields point into privateFields instead of the file.
+ */
+struct SharedMapping {
+    void* addr = MAP_FAILED;
+    size_t size = 0;
+    SnapshotView view;
+    Snapshot privateFields;
+
+    ~SharedMapping() {
+        if (addr != MAP_FAILED) {
+            munmap(addr, size);
+        }
+    }
+};
+
+std::mutex sharedMutex;
+std::shared_ptr<const SharedMapping> sharedMapping;
+
+/**
+ * The path is caller-chosen (often under /tmp) and boot_id is
+ * world-readable, so only trust files that no other user could have
+ * planted or rewritten: owned by this user or root, not group- or
+ * world-writable
+ */
+bool IsTrustedFile(const struct stat& st) {
+    return (st.st_uid == geteuid() || st.st_uid == 0) && !(st.st_mode & (S_IWGRP | S_IWOTH));
+}
+
+/**
+ * Map the file read-only if it is trusted and belongs to this boot
+ */
+std::shared_ptr<SharedMapping> LoadShared(const std::string& path, const std::string& bootId) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    auto mapping = std::make_shared<SharedMapping>();
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && IsTrustedFile(st) && st.st_size > 0) {
+        mapping->size = static_cast<size_t>(st.st_size);
+        mapping->addr = mmap(nullptr, mapping->size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (mapping->addr == MAP_FAILED ||
+        !DecodeShared(static_cast<const uint8_t*>(mapping->addr), mapping->size, bootId, mapping->view)) {
+        return nullptr;
+    }
+    return mapping;
+}
+
+/**
+ * Read this process's private fields and point the mapping's views at them
+ */
+void AttachPrivateFields(SharedMapping& mapping) {
+    ReadPrivateFields(mapping.privateFields);
+    ForEachCategory([](const char*, auto& info, auto& viewInfo) {
+        using Info = std::decay_t<decltype(info)>;
+        using ViewInfo = std::decay_t<decltype(viewInfo)>;
+        NormalizeInfo(info);
+        const auto& source = Fields<Info>::list;
+        const auto& target = Fields<ViewInfo>::list;
+        for (size_t i = 0; i < sizeof(source) / sizeof(source[0]); i++) {
+            if (source[i].flags & FIELD_PRIVATE) {
+                viewInfo.*target[i].member = info.*source[i].member;
+            }
+        }
+    }, mapping.privateFields, mapping.view);
+}
+
+/**
+ * Write the file next to its final location and rename it into place,
+ * so readers never observe a partial file. mkstemp() creates the
+ * temporary file exclusively under an unpredictable name, so a planted
+ * file or symlink is never written through.
+ */
+void WriteShared(const std::string& path, const std::vector<uint8_t>& data) {
+    std::string tmpPath = path + ".XXXXXX";
+    int fd = mkstemp(&tmpPath[0]);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create shared snapshot " + tmpPath + ": " + std::strerror(errno));
+    }
+    // mkstemp() creates it 0600; the contents hold no private fields
+    fchmod(fd, 0644);
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            int err = errno;
+            close(fd);
+            unlink(tmpPath.c_str());
+            throw std::runtime_error("Cannot write shared snapshot " + tmpPath + ": " + std::strerror(err));
+        }
+        written += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        int err = errno;
+        unlink(tmpPath.c_str());
+        throw std::runtime_error("Cannot install shared snapshot " + path + ": " + std::strerror(err));
+    }
+}
+
+/**
+ * Create the parent directories of path (like mkdir -p)
+ */
+void CreateParentDirectories(const std::string& path) {
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+}
+
+#endif // _WIN32
+
+} // namespace
+
+SharedSnapshotInfo OpenSharedSnapshot(const std::string& path) {
+    SharedSnapshotInfo info;
+    info.path = path;
+    info.bootId = GetBootId();
+    if (info.bootId.empty()) {
+        throw std::runtime_error("Shared snapshots are not supported on this platform");
+    }
+
+#ifdef _WIN32
+    throw std::runtime_error("Shared snapshots are not supported on this platform");
+#else
+    // Collect live data below, not a previously opened snapshot
+    CloseSharedSnapshot();
+
+    std::shared_ptr<SharedMapping> mapping = LoadShared(path, info.bootId);
+    if (!mapping) {
+        CreateParentDirectories(path);
+
+        // Serialize creation so a host-wide restart collects only once;
+        // everyone else waits here and then maps the finished file
+        std::string lockPath = path + ".lock";
+        int lockFd = open(lockPath.c_str(), O_RDONLY | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0644);
+        if (lockFd < 0) {
+            throw std::runtime_error("Cannot open " + lockPath + ": " + std::strerror(errno));
+        }
+        // Same trust rule as the snapshot; our own lock file may only be
+        // group-writable through the umask, so reset its mode instead
+        struct stat lockStat;
+        bool trusted = fstat(lockFd, &lockStat) == 0 &&
+            (lockStat.st_uid == geteuid() ? fchmod(lockFd, 0644) == 0 : IsTrustedFile(lockStat));
+        if (!trusted) {
+            close(lockFd);
+            throw std::runtime_error("Refusing lock file " + lockPath + " owned or writable by another user");
+        }
+        while (flock(lockFd, LOCK_EX) != 0 && errno == EINTR) {
+        }
+
+        try {
+            mapping = LoadShared(path, info.bootId);
+            if (!mapping) {
+                WriteShared(path, EncodeShared(GetSnapshot(CATEGORY_STATIC), info.bootId));
+                info.created = true;
+                mapping = LoadShared(path, info.bootId);
+            }
+        } catch (...) {
+            close(lockFd);
+            throw;
+        }
+        close(lockFd);
+
+        if (!mapping) {
+            throw std::runtime_error("Cannot map shared snapshot " + path);
+        }
+    }
+
+    AttachPrivateFields(*mapping);
+
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    sharedMapping = mapping;
+    return info;
+#endif
+}
+
+void CloseSharedSnapshot() {
+#ifndef _WIN32
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    sharedMapping.reset();
+#endif
+}
+
+std::shared_ptr<const SnapshotView> GetSharedSnapshot() {
+#ifndef _WIN32
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (sharedMapping) {
+        // Aliasing pointer: keeps the mapping alive while the view is in use
+        return std::shared_ptr<const SnapshotView>(sharedMapping, &sharedMapping->view);
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace smbios
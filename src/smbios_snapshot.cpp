@@ -0,0 +1,222 @@
+#include "smbios_common.h"
+#include "smbios_fields.h"
+#include "smbios_placeholders.h"
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace smbios {
+
+namespace {
+
+/**
+ * Processor speed is volatile even though the category is static;
+ * sample it when the rest comes from a cached or shared snapshot. ""
+ * where the platform reports no frequency.
+ */
+std::string SampleCurrentSpeed() {
+    std::vector<double> mhz;
+    SampleCpuFrequencies(mhz);
+    for (double value : mhz) {
+        if (std::isfinite(value)) {
+            return FormatMhz(value);
+        }
+    }
+    return "";
+}
+
+/**
+ * Likewise the chassis thermal state, where sensors are available
+ */
+const char* SampleThermalState() {
+    std::vector<double> celsius;
+    ThermalState state = SampleTemperatures(celsius);
+    return state != THERMAL_STATE_UNKNOWN ? ThermalStateName(state) : nullptr;
+}
+
+/**
+ * Read the requested static categories from the platform into snapshot
+ */
+void CollectStatic(unsigned categories, Snapshot& snapshot) {
+    if (categories & CATEGORY_BIOS) {
+        snapshot.bios = GetBiosInfo();
+        NormalizeInfo(snapshot.bios);
+    }
+    if (categories & CATEGORY_SYSTEM) {
+        snapshot.system = GetSystemInfo();
+        NormalizeInfo(snapshot.system);
+    }
+    if (categories & CATEGORY_BOARD) {
+        snapshot.board = GetBoardInfo();
+        NormalizeInfo(snapshot.board);
+    }
+    if (categories & CATEGORY_PROCESSOR) {
+        snapshot.processor = GetProcessorInfo();
+        NormalizeInfo(snapshot.processor);
+    }
+    if (categories & CATEGORY_CHASSIS) {
+        snapshot.chassis = GetChassisInfo();
+        NormalizeInfo(snapshot.chassis);
+    }
+}
+
+std::mutex cacheMutex;
+std::shared_ptr<const PackedSnapshot> cachedSnapshot;
+unsigned cachedCategories = 0;
+
+} // namespace
+
+std::shared_ptr<const PackedSnapshot> GetCachedSnapshot(unsigned categories) {
+    // Held while collecting, so concurrent first callers wait for one
+    // collection instead of each running their own. Categories are added
+    // on first request; readers holding the previous snapshot keep it.
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    unsigned missing = categories & CATEGORY_STATIC & ~cachedCategories;
+    if (missing || !cachedSnapshot) {
+        Snapshot snapshot = cachedSnapshot ? cachedSnapshot->ToSnapshot() : Snapshot();
+        CollectStatic(missing, snapshot);
+        cachedSnapshot = std::make_shared<const PackedSnapshot>(snapshot);
+        cachedCategories |= missing;
+    }
+    return cachedSnapshot;
+}
+
+void ClearSnapshotCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cachedSnapshot.reset();
+    cachedCategories = 0;
+}
+
+SnapshotRef::SnapshotRef(unsigned categories) {
+    if (categories & CATEGORY_STATIC) {
+        // The shared mapping when open, otherwise this process's cache
+        source = GetSharedSnapshot();
+        if (!source) {
+            std::shared_ptr<const PackedSnapshot> cached = GetCachedSnapshot(categories);
+            source = std::shared_ptr<const SnapshotView>(cached, &cached->View());
+        }
+
+        if (categories & CATEGORY_BIOS) {
+            view.bios = source->bios;
+        }
+        if (categories & CATEGORY_SYSTEM) {
+            view.system = source->system;
+        }
+        if (categories & CATEGORY_BOARD) {
+            view.board = source->board;
+        }
+        if (categories & CATEGORY_PROCESSOR) {
+            view.processor = source->processor;
+            currentSpeed = SampleCurrentSpeed();
+            if (!currentSpeed.empty()) {
+                view.processor.currentSpeed = currentSpeed;
+            }
+        }
+        if (categories & CATEGORY_CHASSIS) {
+            view.chassis = source->chassis;
+            if (const char* thermalState = SampleThermalState()) {
+                view.chassis.thermalState = thermalState;
+            }
+        }
+    }
+
+    if (categories & CATEGORY_MEMORY) {
+        memory = GetMemoryInfo();
+        CopyFields(memory, view.memory);
+    }
+}
+
+Snapshot GetSnapshot(unsigned categories) {
+    SnapshotRef ref(categories);
+    Snapshot snapshot;
+    ForEachCategory([](const char*, const auto& viewInfo, auto& info) {
+        CopyFields(viewInfo, info);
+    }, ref.View(), snapshot);
+    return snapshot;
+}
+
+PackedSnapshot::PackedSnapshot(const Snapshot& snapshot) {
+    ForEachCategory([&](const char*, const auto& info) {
+        using Info = std::decay_t<decltype(info)>;
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+            arenaSize += (info.*field.member).size();
+        });
+    }, snapshot);
+
+    arena.reset(new char[arenaSize ? arenaSize : 1]);
+    char* next = arena.get();
+    ForEachCategory([&](const char*, const auto& info, auto& viewInfo) {
+        using Info = std::decay_t<decltype(info)>;
+        using ViewInfo = std::decay_t<decltype(viewInfo)>;
+        const auto& source = Fields<Info>::list;
+        const auto& target = Fields<ViewInfo>::list;
+        for (size_t i = 0; i < sizeof(source) / sizeof(source[0]); i++) {
+            const std::string& value = info.*source[i].member;
+            std::memcpy(next, value.data(), value.size());
+            viewInfo.*target[i].member = std::string_view(next, value.size());
+            next += value.size();
+        }
+    }, snapshot, view);
+}
+
+PackedSnapshot::PackedSnapshot(const PackedSnapshot& other) {
+    *this = other;
+}
+
+PackedSnapshot& PackedSnapshot::operator=(const PackedSnapshot& other) {
+    if (this == &other) {
+        return *this;
+    }
+    if (!other.arena) {
+        arena.reset();
+        arenaSize = 0;
+        view = SnapshotView();
+        return *this;
+    }
+
+    // Copy the arena and rebase every view onto it
+    arenaSize = other.arenaSize;
+    arena.reset(new char[arenaSize ? arenaSize : 1]);
+    std::memcpy(arena.get(), other.arena.get(), arenaSize);
+    view = other.view;
+    ForEachCategory([&](const char*, auto& viewInfo) {
+        using ViewInfo = std::decay_t<decltype(viewInfo)>;
+        ForEachField<ViewInfo>([&](const FieldDescriptor<ViewInfo>& field) {
+            std::string_view& value = viewInfo.*field.member;
+            value = std::string_view(arena.get() + (value.data() - other.arena.get()), value.size());
+        });
+    }, view);
+    return *this;
+}
+
+Snapshot PackedSnapshot::ToSnapshot() const {
+    Snapshot snapshot;
+    ForEachCategory([](const char*, const auto& viewInfo, auto& info) {
+        CopyFields(viewInfo, info);
+    }, view, snapshot);
+    return snapshot;
+}
+
+/**
+ * Compare two snapshots field by field using the descriptor tables.
+ * Only changed fields are reported, in getAllInfo() order.
+ */
+std::vector<FieldChange> DiffSnapshots(const Snapshot& oldSnapshot, const Snapshot& newSnapshot) {
+    std::vector<FieldChange> changes;
+
+    ForEachCategory([&](const char* category, const auto& oldInfo, const auto& newInfo) {
+        using Info = std::decay_t<decltype(oldInfo)>;
+        ForEachField<Info>([&](const FieldDescriptor<Info>& field) {
+            const std::string& before = oldInfo.*field.member;
+            const std::string& after = newInfo.*field.member;
+            if (before != after) {
+                changes.push_back({ std::string(category) + "." + field.name, before, after });
+            }
+        });
+    }, oldSnapshot, newSnapshot);
+
+    return changes;
+}
+
+} // namespace smbios
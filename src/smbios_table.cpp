@@ -0,0 +1,185 @@
+#include "smbios_common.h"
+#include "smbios_table.h"
+#include "smbios_placeholders.h"
+#include <algorithm>
+#include <cstring>
+
+namespace smbios {
+
+namespace {
+
+const uint8_t END_OF_TABLE = 127;
+
+/**
+ * Multiplicative hash for 16-bit handles
+ */
+inline uint32_t HashHandle(uint16_t handle) {
+    return (static_cast<uint32_t>(handle) * 2654435761u) >> 7;
+}
+
+} // namespace
+
+bool Table::Parse(RawTable table) {
+    raw = std::move(table.data);
+    majorVersion = table.majorVersion;
+    minorVersion = table.minorVersion;
+    structures.clear();
+    handleSlots.clear();
+    std::fill(std::begin(typeStart), std::end(typeStart), 0);
+
+    // Walk the table: 4-byte header, formatted area, then a string-set
+    // terminated by a double NUL
+    size_t pos = 0;
+    const size_t total = raw.size();
+    while (pos + 4 <= total) {
+        uint8_t type = raw[pos];
+        uint8_t length = raw[pos + 1];
+        if (length < 4 || pos + length > total) {
+            break;
+        }
+
+        size_t end = pos + length;
+        while (end + 1 < total && (raw[end] != 0 || raw[end + 1] != 0)) {
+            end++;
+        }
+        end = std::min(end + 2, total);
+
+        Structure s;
+        s.type = type;
+        s.length = length;
+        s.handle = static_cast<uint16_t>(raw[pos + 2] | (raw[pos + 3] << 8));
+        s.offset = static_cast<uint32_t>(pos);
+        s.size = static_cast<uint32_t>(end - pos);
+        structures.push_back(s);
+
+        if (type == END_OF_TABLE) {
+            break;
+        }
+        pos = end;
+    }
+
+    // Group by type, keeping table order within each type
+    std::stable_sort(structures.begin(), structures.end(),
+        [](const Structure& a, const Structure& b) { return a.type < b.type; });
+    for (const Structure& s : structures) {
+        typeStart[s.type + 1]++;
+    }
+    for (size_t i = 1; i < 257; i++) {
+        typeStart[i] += typeStart[i - 1];
+    }
+
+    // Open-addressed handle table at <= 50% load
+    size_t capacity = 16;
+    while (capacity < structures.size() * 2) {
+        capacity <<= 1;
+    }
+    handleSlots.assign(capacity, HandleSlot{0, EMPTY_SLOT});
+    handleMask = static_cast<uint32_t>(capacity - 1);
+    for (uint32_t i = 0; i < structures.size(); i++) {
+        uint32_t slot = HashHandle(structures[i].handle) & handleMask;
+        while (handleSlots[slot].index != EMPTY_SLOT) {
+            if (handleSlots[slot].handle == structures[i].handle) {
+                break; // Duplicate handle, first one wins
+            }
+            slot = (slot + 1) & handleMask;
+        }
+        if (handleSlots[slot].index == EMPTY_SLOT) {
+            handleSlots[slot].handle = structures[i].handle;
+            handleSlots[slot].index = i;
+        }
+    }
+
+    return !structures.empty();
+}
+
+const Structure* Table::FindFirst(uint8_t type) const {
+    return TypeCount(type) > 0 ? TypeBegin(type) : nullptr;
+}
+
+const Structure* Table::FindByHandle(uint16_t handle) const {
+    if (handleSlots.empty()) {
+        return nullptr;
+    }
+    uint32_t slot = HashHandle(handle) & handleMask;
+    while (handleSlots[slot].index != EMPTY_SLOT) {
+        if (handleSlots[slot].handle == handle) {
+            return &structures[handleSlots[slot].index];
+        }
+        slot = (slot + 1) & handleMask;
+    }
+    return nullptr;
+}
+
+uint8_t Table::Byte(const Structure& s, size_t off) const {
+    return Has(s, off, 1) ? raw[s.offset + off] : 0;
+}
+
+uint16_t Table::Word(const Structure& s, size_t off) const {
+    if (!Has(s, off, 2)) return 0;
+    const uint8_t* p = raw.data() + s.offset + off;
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t Table::DWord(const Structure& s, size_t off) const {
+    if (!Has(s, off, 4)) return 0;
+    const uint8_t* p = raw.data() + s.offset + off;
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t Table::QWord(const Structure& s, size_t off) const {
+    if (!Has(s, off, 8)) return 0;
+    return static_cast<uint64_t>(DWord(s, off)) | (static_cast<uint64_t>(DWord(s, off + 4)) << 32);
+}
+
+std::string Table::String(const Structure& s, size_t off) const {
+    return StringAt(s, Byte(s, off));
+}
+
+std::string Table::StringAt(const Structure& s, uint8_t index) const {
+    if (index == 0) {
+        return "";
+    }
+
+    const char* p = reinterpret_cast<const char*>(raw.data() + s.offset + s.length);
+    const char* end = reinterpret_cast<const char*>(raw.data() + s.offset + s.size);
+    for (uint8_t i = 1; p < end && *p != '\0'; i++) {
+        size_t len = strnlen(p, end - p);
+        if (i == index) {
+            return std::string(p, len);
+        }
+        p += len + 1;
+    }
+    return "";
+}
+
+std::vector<std::string> Table::Strings(const Structure& s) const {
+    std::vector<std::string> result;
+    const char* p = reinterpret_cast<const char*>(raw.data() + s.offset + s.length);
+    const char* end = reinterpret_cast<const char*>(raw.data() + s.offset + s.size);
+    while (p < end && *p != '\0') {
+        size_t len = strnlen(p, end - p);
+        result.emplace_back(p, len);
+        p += len + 1;
+    }
+    return result;
+}
+
+std::string Table::Text(const Structure& s, size_t off) const {
+    std::string text = TrimString(String(s, off));
+    if (IsPlaceholder(text)) {
+        text.clear();
+    }
+    return text;
+}
+
+const Table& GetTable() {
+    static const Table table = [] {
+        Table t;
+        t.Parse(ReadRawTable());
+        return t;
+    }();
+    return table;
+}
+
+} // namespace smbios
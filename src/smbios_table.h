@@ -0,0 +1,129 @@
+#ifndef SMBIOS_TABLE_H
+#define SMBIOS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace smbios {
+
+/**
+ * Raw SMBIOS structure table as handed out by the firmware
+ */
+struct RawTable {
+    std::vector<uint8_t> data;
+    uint8_t majorVersion = 0;
+    uint8_t minorVersion = 0;
+};
+
+/**
+ * Location of a single structure inside the raw table
+ */
+struct Structure {
+    uint8_t type;
+    uint8_t length;     // Length of the formatted area
+    uint16_t handle;
+    uint32_t offset;    // Offset of the structure header in the table
+    uint32_t size;      // Formatted area plus string-set
+};
+
+/**
+ * Parsed SMBIOS table with a type and handle index.
+ *
+ * The table is walked once on Parse(). Structures are stored grouped by
+ * type (table order is preserved within a type) so GetByType() is a slice
+ * lookup, and handles are resolved through a flat open-addressed table so
+ * FindByHandle() does not scan.
+ */
+class Table {
+public:
+    bool Parse(RawTable raw);
+
+    bool Empty() const { return structures.empty(); }
+    size_t Count() const { return structures.size(); }
+    uint8_t MajorVersion() const { return majorVersion; }
+    uint8_t MinorVersion() const { return minorVersion; }
+
+    /**
+     * Version check against the table's SMBIOS revision
+     */
+    bool AtLeast(uint8_t major, uint8_t minor) const {
+        return majorVersion > major || (majorVersion == major && minorVersion >= minor);
+    }
+
+    const Structure* begin() const { return structures.data(); }
+    const Structure* end() const { return structures.data() + structures.size(); }
+
+    /**
+     * All structures of the given type, in table order
+     */
+    const Structure* TypeBegin(uint8_t type) const { return structures.data() + typeStart[type]; }
+    const Structure* TypeEnd(uint8_t type) const { return structures.data() + typeStart[type + 1]; }
+    size_t TypeCount(uint8_t type) const { return typeStart[type + 1] - typeStart[type]; }
+
+    /**
+     * First structure of the given type, or nullptr
+     */
+    const Structure* FindFirst(uint8_t type) const;
+
+    /**
+     * Structure with the given handle, or nullptr
+     */
+    const Structure* FindByHandle(uint16_t handle) const;
+
+    /**
+     * Field accessors for the formatted area. Offsets are relative to the
+     * structure header; reads past the formatted length return 0 so callers
+     * can decode newer fields without checking the SMBIOS version first.
+     */
+    const uint8_t* Data(const Structure& s) const { return raw.data() + s.offset; }
+    uint8_t Byte(const Structure& s, size_t off) const;
+    uint16_t Word(const Structure& s, size_t off) const;
+    uint32_t DWord(const Structure& s, size_t off) const;
+    uint64_t QWord(const Structure& s, size_t off) const;
+    bool Has(const Structure& s, size_t off, size_t width) const { return off + width <= s.length; }
+
+    /**
+     * String referenced by the byte at `off` (1-based string number)
+     */
+    std::string String(const Structure& s, size_t off) const;
+    std::string StringAt(const Structure& s, uint8_t index) const;
+    std::vector<std::string> Strings(const Structure& s) const;
+
+    /**
+     * Like String(), trimmed, and "" for OEM placeholders; what decoders
+     * should store
+     */
+    std::string Text(const Structure& s, size_t off) const;
+
+private:
+    struct HandleSlot {
+        uint16_t handle;
+        uint32_t index;
+    };
+    static const uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+    std::vector<uint8_t> raw;
+    std::vector<Structure> structures;
+    uint32_t typeStart[257] = {};
+    std::vector<HandleSlot> handleSlots;
+    uint32_t handleMask = 0;
+    uint8_t majorVersion = 0;
+    uint8_t minorVersion = 0;
+};
+
+/**
+ * Platform-specific: read the raw structure table from the firmware.
+ * Returns an empty table if it is not accessible.
+ */
+RawTable ReadRawTable();
+
+/**
+ * Process-wide table, read and indexed on first use
+ */
+const Table& GetTable();
+
+} // namespace smbios
+
+#endif // SMBIOS_TABLE_H
@@ -0,0 +1,230 @@
+#include "smbios_common.h"
+#include "smbios_cpuid.h"
+#include "smbios_table.h"
+#include <cstring>
+#include <string_view>
+
+namespace smbios {
+
+namespace {
+
+const uint8_t TYPE_BIOS = 0;
+const uint8_t TYPE_SYSTEM = 1;
+
+struct Signature {
+    const char* text;
+    const char* hypervisor;
+};
+
+/**
+ * CPUID 0x40000000 vendor signatures (EBX, ECX, EDX; NULs stripped)
+ */
+const Signature CPUID_SIGNATURES[] = {
+    { "KVMKVMKVM", "kvm" },
+    { "Linux KVM Hv", "kvm" },
+    { "Microsoft Hv", "hyperv" },
+    { "VMwareVMware", "vmware" },
+    { "XenVMMXenVMM", "xen" },
+    { "TCGTCGTCGTCG", "qemu" },
+    { "VBoxVBoxVBox", "virtualbox" },
+    { " lrpepyh  vr", "parallels" },
+    { "prl hyperv  ", "parallels" },
+    { "bhyve bhyve ", "bhyve" },
+    { "ACRNACRNACRN", "acrn" },
+};
+
+/**
+ * SMBIOS system manufacturer/product pairs set by hypervisors, matched
+ * exactly (null matches anything, a trailing '*' a prefix). Substrings
+ * are not enough: physical Chromebooks say "Google", and "Xen" or "KVM"
+ * turn up in unrelated product names.
+ */
+struct SystemSignature {
+    const char* manufacturer;
+    const char* product;
+    const char* hypervisor;
+};
+
+const SystemSignature SMBIOS_SIGNATURES[] = {
+    { "Amazon EC2", nullptr, "amazon" },
+    { "Google", "Google Compute Engine", "google" },
+    { "Microsoft Corporation", "Virtual Machine", "hyperv" },
+    { "QEMU", nullptr, "qemu" },
+    { nullptr, "Standard PC (*", "qemu" },
+    { nullptr, "KVM", "kvm" },
+    { "OpenStack Foundation", nullptr, "kvm" },
+    { "VMware, Inc.", nullptr, "vmware" },
+    { "innotek GmbH", "VirtualBox", "virtualbox" },
+    { "Xen", "HVM domU", "xen" },
+    { "Parallels Software International Inc.", nullptr, "parallels" },
+    { "Parallels International GmbH.", nullptr, "parallels" },
+    { nullptr, "BHYVE", "bhyve" },
+};
+
+bool MatchesPattern(std::string_view text, const char* pattern) {
+    if (!pattern) {
+        return true;
+    }
+    std::string_view expected(pattern);
+    if (!expected.empty() && expected.back() == '*') {
+        expected.remove_suffix(1);
+        return text.substr(0, expected.size()) == expected;
+    }
+    return text == expected;
+}
+
+const char* MatchSystem(std::string_view manufacturer, std::string_view product) {
+    for (const SystemSignature& known : SMBIOS_SIGNATURES) {
+        if (MatchesPattern(manufacturer, known.manufacturer) && MatchesPattern(product, known.product)) {
+            return known.hypervisor;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef SMBIOS_HAVE_CPUID
+
+const char* MatchCpuid(std::string_view signature) {
+    for (const Signature& known : CPUID_SIGNATURES) {
+        if (signature == known.text) {
+            return known.hypervisor;
+        }
+    }
+    return nullptr;
+}
+
+std::string CpuidSignature(uint32_t leaf) {
+    CpuidRegisters regs = Cpuid(leaf);
+    char text[12];
+    std::memcpy(text, &regs.ebx, 4);
+    std::memcpy(text + 4, &regs.ecx, 4);
+    std::memcpy(text + 8, &regs.edx, 4);
+    return std::string(text, strnlen(text, sizeof(text)));
+}
+
+/**
+ * Hypervisor from the vendor leaves. Hypervisors that also offer Hyper-V
+ * enlightenments put "Microsoft Hv" at 0x40000000 and their own
+ * signature at a later 0x100 step, so keep looking past Hyper-V.
+ *
+ * A Windows host with Hyper-V, VBS or WSL2 enabled runs in the Hyper-V
+ * root partition, which sees the same bit and signature. Only the root
+ * may create partitions (0x40000003 EBX bit 0), so that settles it as
+ * bare metal: `rootPartition` is set and false returned.
+ */
+bool DetectFromCpuid(VirtualizationInfo& info, bool& rootPartition) {
+    info.hypervisorBit = (Cpuid(1).ecx & (1u << 31)) != 0;
+    if (!info.hypervisorBit) {
+        return false;
+    }
+
+    const char* found = nullptr;
+    for (uint32_t base = 0x40000000; base < 0x40010000; base += 0x100) {
+        if (Cpuid(base).eax < base) {
+            break;
+        }
+        std::string signature = CpuidSignature(base);
+        const char* hypervisor = MatchCpuid(signature);
+        if (base == 0x40000000) {
+            info.cpuidVendor = signature;
+        }
+        if (hypervisor) {
+            found = hypervisor;
+            if (std::strcmp(hypervisor, "hyperv") != 0) {
+                break;
+            }
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    if (std::strcmp(found, "hyperv") == 0 && Cpuid(0x40000000).eax >= 0x40000003 &&
+        (Cpuid(0x40000003).ebx & 1) != 0) {
+        rootPartition = true;
+        return false;
+    }
+    info.hypervisor = found;
+    return true;
+}
+
+#endif // SMBIOS_HAVE_CPUID
+
+/**
+ * Hypervisor from the SMBIOS system manufacturer/product or the "virtual
+ * machine" BIOS characteristic. Uses the raw table when readable (no WMI
+ * on Windows), else the cached DMI fields. On x86 the strings are only
+ * trusted with the hypervisor bit or the VM characteristic set, so bare
+ * metal that happens to match (e.g. "Amazon EC2" metal instances) stays
+ * bare metal.
+ */
+bool DetectFromSmbios(VirtualizationInfo& info) {
+#ifdef SMBIOS_HAVE_CPUID
+    const bool needsVmFlag = !info.hypervisorBit;
+#else
+    const bool needsVmFlag = false;
+#endif
+    const Table& table = GetTable();
+    std::string manufacturer;
+    std::string product;
+    bool vmFlag = false;
+    if (!table.Empty()) {
+        if (const Structure* s = table.FindFirst(TYPE_SYSTEM)) {
+            manufacturer = table.String(*s, 0x04);
+            product = table.String(*s, 0x05);
+        }
+        if (const Structure* s = table.FindFirst(TYPE_BIOS)) {
+            // BIOS Characteristics Extension Byte 2, bit 4 (SMBIOS 2.4+)
+            vmFlag = (table.Byte(*s, 0x13) & 0x10) != 0;
+        }
+    } else if (!needsVmFlag) {
+        std::shared_ptr<const PackedSnapshot> cached = GetCachedSnapshot(CATEGORY_SYSTEM);
+        const SnapshotView& view = cached->View();
+        manufacturer = std::string(view.system.manufacturer);
+        product = std::string(view.system.productName);
+    }
+
+    if (needsVmFlag && !vmFlag) {
+        return false;
+    }
+    if (const char* hypervisor = MatchSystem(TrimView(manufacturer), TrimView(product))) {
+        info.hypervisor = hypervisor;
+        return true;
+    }
+    if (vmFlag) {
+        info.hypervisor = "unknown";
+        return true;
+    }
+    return false;
+}
+
+VirtualizationInfo Detect() {
+    VirtualizationInfo info;
+    bool fromCpuid = false;
+    bool rootPartition = false;
+#ifdef SMBIOS_HAVE_CPUID
+    fromCpuid = DetectFromCpuid(info, rootPartition);
+#endif
+
+    if (fromCpuid || rootPartition) {
+        info.source = "cpuid";
+    } else if (DetectFromSmbios(info)) {
+        info.source = "smbios";
+    } else if (!(info.hypervisor = ReadHypervisorHint()).empty()) {
+        info.source = "os";
+    } else if (info.hypervisorBit) {
+        // Hidden or unrecognized vendor, but the CPU says so
+        info.hypervisor = "unknown";
+        info.source = "cpuid";
+    }
+    info.virtualized = !info.hypervisor.empty();
+    return info;
+}
+
+} // namespace
+
+const VirtualizationInfo& GetVirtualization() {
+    static const VirtualizationInfo info = Detect();
+    return info;
+}
+
+} // namespace smbios
@@ -1,15 +1,28 @@
 #include "../smbios_common.h"
+#include "../smbios_placeholders.h"
+#include "../smbios_table.h"
 
 #ifdef _WIN32
 
 #define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
 #include <windows.h>
 #include <comdef.h>
 #include <Wbemidl.h>
+#include <powrprof.h>
+#include <winternl.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #pragma comment(lib, "wbemuuid.lib")
+#pragma comment(lib, "powrprof.lib")
+#pragma comment(lib, "ntdll.lib")
 
 namespace smbios {
 
@@ -147,6 +160,36 @@ public:
     }
 };
 
+RawTable ReadRawTable() {
+    RawTable table;
+    
+    // 'RSMB' returns a RawSMBIOSData header followed by the structure table
+    UINT size = GetSystemFirmwareTable('RSMB', 0, nullptr, 0);
+    if (size < 8) {
+        return table;
+    }
+    
+    std::vector<uint8_t> buffer(size);
+    if (GetSystemFirmwareTable('RSMB', 0, buffer.data(), size) != size) {
+        return table;
+    }
+    
+    DWORD length = buffer[4] | (buffer[5] << 8) | (buffer[6] << 16) | (buffer[7] << 24);
+    if (length > size - 8) {
+        length = size - 8;
+    }
+    
+    table.majorVersion = buffer[1];
+    table.minorVersion = buffer[2];
+    table.data.assign(buffer.begin() + 8, buffer.begin() + 8 + length);
+    return table;
+}
+
+std::string GetBootId() {
+    // No per-boot identifier is exposed; shared snapshots are unsupported
+    return "";
+}
+
 BiosInfo GetBiosInfo() {
     BiosInfo info;
     WMIQuery wmi;
@@ -170,7 +213,7 @@ SystemInfo GetSystemInfo() {
     
     // Try to get serial number from ComputerSystemProduct
     std::string serial = wmi.QueryProperty(L"Win32_ComputerSystemProduct", L"IdentifyingNumber");
-    if (serial.empty() || serial == "To Be Filled By O.E.M.") {
+    if (serial.empty() || IsIdentityPlaceholder("serialNumber", serial)) {
         serial = wmi.QueryProperty(L"Win32_BIOS", L"SerialNumber");
     }
     info.serialNumber = serial;
@@ -206,6 +249,12 @@ ProcessorInfo GetProcessorInfo() {
     info.processorFamily = wmi.QueryProperty(L"Win32_Processor", L"Family");
     info.maxSpeed = wmi.QueryProperty(L"Win32_Processor", L"MaxClockSpeed");
     info.currentSpeed = wmi.QueryProperty(L"Win32_Processor", L"CurrentClockSpeed");
+    // WMI reports whole MHz; match the format of the other platforms
+    for (std::string* speed : { &info.maxSpeed, &info.currentSpeed }) {
+        if (!speed->empty() && std::isdigit(static_cast<unsigned char>(speed->front()))) {
+            *speed = FormatMhz(std::strtod(speed->c_str(), nullptr));
+        }
+    }
     info.coreCount = wmi.QueryProperty(L"Win32_Processor", L"NumberOfCores");
     info.threadCount = wmi.QueryProperty(L"Win32_Processor", L"NumberOfLogicalProcessors");
     info.l2CacheSize = wmi.QueryProperty(L"Win32_Processor", L"L2CacheSize");
@@ -250,6 +299,274 @@ ChassisInfo GetChassisInfo() {
     return info;
 }
 
+// Documented for CallNtPowerInformation but not declared in the SDK headers
+typedef struct _PROCESSOR_POWER_INFORMATION {
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+} PROCESSOR_POWER_INFORMATION;
+
+void SampleCpuFrequencies(std::vector<double>& mhz) {
+    // ProcessorInformation only covers the calling thread's processor group
+    DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    std::vector<PROCESSOR_POWER_INFORMATION> power(count);
+    
+    LONG status = CallNtPowerInformation(
+        ProcessorInformation, nullptr, 0,
+        power.data(), static_cast<ULONG>(power.size() * sizeof(PROCESSOR_POWER_INFORMATION))
+    );
+    if (status != 0) {
+        mhz.clear();
+        return;
+    }
+    
+    mhz.assign(count, NAN);
+    for (const PROCESSOR_POWER_INFORMATION& p : power) {
+        if (p.Number < count && p.CurrentMhz != 0) {
+            mhz[p.Number] = static_cast<double>(p.CurrentMhz);
+        }
+    }
+}
+
+void SampleMemoryStats(double (&stats)[MEMORY_STAT_COUNT]) {
+    for (double& value : stats) {
+        value = NAN;
+    }
+    
+    // Windows has no separate free/buffer/cache split here; the swap
+    // slots carry the commit limit and the commit still available
+    MEMORYSTATUSEX memStatus;
+    memStatus.dwLength = sizeof(memStatus);
+    if (GlobalMemoryStatusEx(&memStatus)) {
+        stats[MEMORY_STAT_TOTAL] = static_cast<double>(memStatus.ullTotalPhys);
+        stats[MEMORY_STAT_AVAILABLE] = static_cast<double>(memStatus.ullAvailPhys);
+        stats[MEMORY_STAT_SWAP_TOTAL] = static_cast<double>(memStatus.ullTotalPageFile);
+        stats[MEMORY_STAT_SWAP_FREE] = static_cast<double>(memStatus.ullAvailPageFile);
+    }
+}
+
+namespace {
+
+// Guards the reused query buffer
+std::mutex loadMutex;
+
+} // namespace
+
+double SampleCpuLoads(CpuLoadState& state, std::vector<double>& load) {
+    static std::vector<SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> times;
+    std::lock_guard<std::mutex> lock(loadMutex);
+    
+    // Per-processor times cover the calling thread's processor group;
+    // kernel time includes idle time
+    times.resize(GetActiveProcessorCount(ALL_PROCESSOR_GROUPS));
+    ULONG returned = 0;
+    NTSTATUS status = NtQuerySystemInformation(
+        SystemProcessorPerformanceInformation, times.data(),
+        static_cast<ULONG>(times.size() * sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION)), &returned
+    );
+    size_t count = status >= 0 ? returned / sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION) : 0;
+    
+    state.cpus.resize(std::max(state.cpus.size(), count));
+    load.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t idle = times[i].IdleTime.QuadPart;
+        uint64_t total = times[i].KernelTime.QuadPart + times[i].UserTime.QuadPart;
+        load[i] = UpdateCpuLoad(state.cpus[i], total, idle);
+    }
+    
+    FILETIME idleTime, kernelTime, userTime;
+    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
+        return NAN;
+    }
+    auto ticks = [](const FILETIME& ft) {
+        return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    return UpdateCpuLoad(state.system, ticks(kernelTime) + ticks(userTime), ticks(idleTime));
+}
+
+std::string ReadCpuFlags() {
+    // x86 uses CPUID directly; this covers Windows on ARM
+    std::string flags = "fp asimd";
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE)) {
+        flags += " aes pmull sha1 sha2";
+    }
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE)) {
+        flags += " crc32";
+    }
+    if (IsProcessorFeaturePresent(PF_ARM_V81_ATOMIC_INSTRUCTIONS_AVAILABLE)) {
+        flags += " atomics";
+    }
+#ifdef PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE
+    if (IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE)) {
+        flags += " asimddp";
+    }
+#endif
+    return flags;
+}
+
+std::vector<NumaNode> GetNumaNodes() {
+    std::vector<NumaNode> nodes;
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) {
+        return nodes;
+    }
+    
+    // Windows reports free memory and processors per node, but neither
+    // the node size, distances nor huge page pools
+    for (ULONG id = 0; id <= highest; id++) {
+        GROUP_AFFINITY affinity = {};
+        if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(id), &affinity)) {
+            continue;
+        }
+        
+        NumaNode node;
+        node.id = id;
+        for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+            if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+                node.cpus.push_back(affinity.Group * 64 + bit);
+            }
+        }
+        
+        ULONGLONG available = 0;
+        if (GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(id), &available)) {
+            node.memFree = available;
+        }
+        nodes.push_back(std::move(node));
+    }
+    
+    return nodes;
+}
+
+std::vector<CacheInstance> GetCacheTopology() {
+    std::vector<CacheInstance> caches;
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationCache, nullptr, &length);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return caches;
+    }
+    
+    std::vector<uint8_t> buffer(length);
+    auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationCache, info, &length)) {
+        return caches;
+    }
+    
+    // Each record is already one cache instance
+    for (DWORD offset = 0; offset < length; ) {
+        auto* entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        const CACHE_RELATIONSHIP& rel = entry->Cache;
+        offset += entry->Size;
+        if (rel.Type == CacheTrace) {
+            continue;
+        }
+        
+        CacheInstance cache;
+        cache.level = rel.Level;
+        cache.type = rel.Type == CacheData ? "Data" : rel.Type == CacheInstruction ? "Instruction" : "Unified";
+        cache.size = rel.CacheSize;
+        cache.lineSize = rel.LineSize;
+        cache.ways = rel.Associativity == CACHE_FULLY_ASSOCIATIVE ? 0 : rel.Associativity;
+        if (cache.ways != 0 && cache.lineSize != 0) {
+            cache.sets = static_cast<uint32_t>(cache.size / (static_cast<uint64_t>(cache.ways) * cache.lineSize));
+        }
+        for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+            if (rel.GroupMask.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+                cache.cpus.push_back(rel.GroupMask.Group * 64 + bit);
+            }
+        }
+        cache.cpuMask.assign(cache.cpus.empty() ? 0 : cache.cpus.back() / 32 + 1, 0);
+        for (uint32_t cpu : cache.cpus) {
+            cache.cpuMask[cpu / 32] |= 1u << (cpu % 32);
+        }
+        caches.push_back(std::move(cache));
+    }
+    
+    std::sort(caches.begin(), caches.end(), [](const CacheInstance& a, const CacheInstance& b) {
+        return std::tie(a.level, a.type, a.cpus) < std::tie(b.level, b.type, b.cpus);
+    });
+    return caches;
+}
+
+EffectiveLimits GetEffectiveLimits() {
+    EffectiveLimits limits;
+    limits.hostCpus = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    
+    // The process affinity mask covers the primary processor group only
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        for (uint32_t bit = 0; bit < sizeof(DWORD_PTR) * 8; bit++) {
+            if (processMask & (static_cast<DWORD_PTR>(1) << bit)) {
+                limits.cpus.push_back(bit);
+            }
+        }
+    }
+    
+    MEMORYSTATUSEX memStatus;
+    memStatus.dwLength = sizeof(memStatus);
+    if (GlobalMemoryStatusEx(&memStatus)) {
+        limits.hostMemory = memStatus.ullTotalPhys;
+    }
+    
+    // Job objects are the Windows counterpart of cgroups (containers,
+    // service managers); a null handle queries the caller's job
+    BOOL inJob = FALSE;
+    if (IsProcessInJob(GetCurrentProcess(), nullptr, &inJob) && inJob) {
+        limits.source = "job";
+        
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION extended = {};
+        if (QueryInformationJobObject(nullptr, JobObjectExtendedLimitInformation,
+                                      &extended, sizeof(extended), nullptr)) {
+            DWORD flags = extended.BasicLimitInformation.LimitFlags;
+            if (flags & JOB_OBJECT_LIMIT_JOB_MEMORY) {
+                limits.memoryLimit = extended.JobMemoryLimit;
+            }
+            if ((flags & JOB_OBJECT_LIMIT_PROCESS_MEMORY) &&
+                (limits.memoryLimit == 0 || extended.ProcessMemoryLimit < limits.memoryLimit)) {
+                limits.memoryLimit = extended.ProcessMemoryLimit;
+            }
+        }
+        
+        JOBOBJECT_CPU_RATE_CONTROL_INFORMATION rate = {};
+        if (QueryInformationJobObject(nullptr, JobObjectCpuRateControlInformation,
+                                      &rate, sizeof(rate), nullptr) &&
+            (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE) &&
+            (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP)) {
+            // CpuRate is in 1/100 of a percent of all processors
+            limits.cpuQuota = rate.CpuRate / 10000.0 * limits.hostCpus;
+        }
+    }
+    
+    limits.effectiveCpus = static_cast<uint32_t>(limits.cpus.size());
+    if (limits.cpuQuota > 0) {
+        uint32_t quotaCpus = static_cast<uint32_t>(std::max(1.0, std::ceil(limits.cpuQuota)));
+        limits.effectiveCpus = std::min(limits.effectiveCpus, quotaCpus);
+    }
+    limits.effectiveMemory = limits.memoryLimit != 0 && limits.memoryLimit < limits.hostMemory
+        ? limits.memoryLimit : limits.hostMemory;
+    
+    return limits;
+}
+
+std::vector<ThermalSensor> GetThermalSensors() {
+    // MSAcpi_ThermalZoneTemperature needs administrator rights and is
+    // rarely implemented; ThermalState comes from Win32_ComputerSystem
+    return {};
+}
+
+ThermalState SampleTemperatures(std::vector<double>& celsius) {
+    celsius.clear();
+    return THERMAL_STATE_UNKNOWN;
+}
+
+std::string ReadHypervisorHint() {
+    // Windows exposes nothing cheaper than CPUID and the SMBIOS table
+    return "";
+}
+
 } // namespace smbios
 
 #endif // _WIN32